@@ -6,309 +6,5990 @@
 #include "rapidxml-1.13/rapidxml.hpp"
 
 #include <string>
-#include <fstream>
-#include <sstream>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <map>
+#include <tuple>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <cctype>
 
-// Microsoft Visual C++ POSIX Warning Workarounds
-#if defined (_MSC_VER)
-# define stricmp _stricmp
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if ! defined (_WIN32)
+# include <sys/mman.h>
+# include <sys/socket.h>
+# include <sys/time.h>
+# include <sys/un.h>
+# include <fcntl.h>
+# include <unistd.h>
+# include <signal.h>
+# include <cerrno>
+#endif
+
+using namespace rapidxml;
+
+// The registry is parsed non-destructively, so nothing rapidxml hands back is NUL terminated; names and
+//   values are always read as (pointer, length) views into the source buffer.
+const int glv_parse_flags = parse_non_destructive;
+
+std::string_view xml_name (const xml_base<>* node)
+{
+  return std::string_view (node->name (), node->name_size ());
+}
+
+std::string_view xml_value (const xml_base<>* node)
+{
+  return std::string_view (node->value (), node->value_size ());
+}
+
+// Empty when the attribute is absent
+std::string_view xml_attribute_value (const xml_node<>* node, const char* name)
+{
+  xml_attribute<>* attribute = node->first_attribute (name);
+  return attribute != NULL ? xml_value (attribute) : std::string_view ();
+}
+
+// Character data with the predefined entities (and numeric references below 128) replaced
+std::string decode_entities (std::string_view text)
+{
+  static const char* const entities [][2] = { { "&lt;", "<" }, { "&gt;", ">" }, { "&amp;", "&" }, { "&quot;", "\"" }, { "&apos;", "'" } };
+
+  std::string decoded;
+  decoded.reserve (text.size ());
+
+  while (! text.empty ()) {
+    bool replaced = false;
+    for (size_t i = 0; i < sizeof (entities) / sizeof (entities [0]) && text [0] == '&' && (! replaced); i++) {
+      const size_t len = strlen (entities [i][0]);
+      if (text.substr (0, len) == entities [i][0]) {
+        decoded += entities [i][1];
+        text.remove_prefix (len);
+        replaced = true;
+      }
+    }
+
+    const size_t semicolon = text.find (';');
+    if ((! replaced) && text.substr (0, 2) == "&#" && semicolon != std::string_view::npos && semicolon <= 6) {
+      const long code = text [2] == 'x' ? strtol (std::string (text.substr (3, semicolon - 3)).c_str (), NULL, 16) :
+                                          strtol (std::string (text.substr (2, semicolon - 2)).c_str (), NULL, 10);
+      if (code > 0 && code < 128) {
+        decoded += (char)code;
+        text.remove_prefix (semicolon + 1);
+        replaced = true;
+      }
+    }
+
+    if (! replaced) {
+      decoded += text [0];
+      text.remove_prefix (1);
+    }
+  }
+
+  return decoded;
+}
+
+// Expands to the ("%.*s") arguments for a string view
+#define GLV_FMT_STR(view) (int)(view).size (), (view).data ()
+
+// What a <feature> does with a name, in the order the lifecycle is printed
+enum glv_verb {
+  GLV_REQUIRE   = 0,
+  GLV_DEPRECATE = 1,
+  GLV_REMOVE    = 2,
+
+  GLV_NUM_VERBS
+};
+
+const char* glv_verb_names [GLV_NUM_VERBS] = { "require", "deprecate",     "remove"     };
+const char* glv_verb_desc  [GLV_NUM_VERBS] = { "Core in", "Deprecated in", "Removed in" };
+
+// APIs an extension may be "supported" on
+enum glv_api_bits {
+  GLV_API_GL     = 0x01,
+  GLV_API_GLCORE = 0x02,
+  GLV_API_GLES1  = 0x04,
+  GLV_API_GLES2  = 0x08,
+  GLV_API_GLSC2  = 0x10,
+
+  GLV_NUM_APIS   = 5
+};
+
+const char* glv_api_names [GLV_NUM_APIS] = { "gl", "glcore", "gles1", "gles2", "glsc2" };
+
+// Parses hex (0x...), decimal or negative integers without needing a terminator; false if text is not a number
+bool parse_integer (std::string_view text, unsigned long long& value)
+{
+  const bool negative = (! text.empty ()) && text [0] == '-';
+  if (negative)
+    text.remove_prefix (1);
+
+  unsigned int base = 10;
+  if (text.size () > 2 && text [0] == '0' && (text [1] == 'x' || text [1] == 'X')) {
+    base = 16;
+    text.remove_prefix (2);
+  }
+
+  if (text.empty ())
+    return false;
+
+  value = 0;
+  for (size_t i = 0; i < text.size (); i++) {
+    const char   c     = text [i];
+    unsigned int digit = base;
+
+    if (c >= '0' && c <= '9')
+      digit = c - '0';
+    else if (c >= 'a' && c <= 'f')
+      digit = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+      digit = c - 'A' + 10;
+
+    if (digit >= base)
+      return false;
+
+    value = value * base + digit;
+  }
+
+  if (negative)
+    value = (unsigned long long)(-(long long)value);
+
+  return true;
+}
+
+// Values are hex, decimal or negative; type="ull" entries need the full 64 bits
+unsigned long long parse_enum_value (xml_node<>* enum_node)
+{
+  unsigned long long value = 0;
+  parse_integer (xml_attribute_value (enum_node, "value"), value);
+  return value;
+}
+
+// Feature "number" attributes, e.g. "4.5"
+double parse_version (std::string_view number)
+{
+  char version [32] = { };
+  number.copy (version, std::min (number.size (), sizeof (version) - 1));
+  return atof (version);
+}
+
+glv_verb parse_verb (std::string_view verb)
+{
+  for (int i = 0; i < GLV_NUM_VERBS; i++) {
+    if (glv_verb_names [i] == verb)
+      return (glv_verb)i;
+  }
+
+  return GLV_NUM_VERBS;
+}
+
+// Parses a '|' separated API list such as "gl|glcore|gles2"
+unsigned int parse_api_mask (std::string_view apis)
+{
+  unsigned int mask = 0;
+
+  while (! apis.empty ()) {
+    const size_t           len = std::min (apis.find ('|'), apis.size ());
+    const std::string_view api = apis.substr (0, len);
+    for (int i = 0; i < GLV_NUM_APIS; i++) {
+      if (glv_api_names [i] == api)
+        mask |= (1 << i);
+    }
+    apis.remove_prefix (std::min (len + 1, apis.size ()));
+  }
+
+  return mask;
+}
+
+std::string format_api_mask (unsigned int mask)
+{
+  std::string apis;
+
+  for (int i = 0; i < GLV_NUM_APIS; i++) {
+    if (mask & (1 << i)) {
+      if (! apis.empty ())
+        apis += '|';
+      apis += glv_api_names [i];
+    }
+  }
+
+  return apis;
+}
+
+
+//
+// Registry database
+//
+//   Everything a query needs, flattened into tables of fixed-layout records that refer to each other by
+//     index and to text by (offset, length) into one string blob. The same tables are built from gl.xml,
+//     written to and mapped back from a .glvsdb snapshot, so none of them may hold a pointer.
+//
+typedef uint32_t glv_id;
+
+const glv_id GLV_NONE = 0xFFFFFFFFu;
+
+struct glv_str {
+  uint32_t offset;
+  uint32_t length;
+};
+
+// One per distinct name in the registry; what it names and which records mention it
+struct glv_name_rec {
+  glv_str  text;
+  glv_id   command;        // GLV_NONE unless it names a <command>
+  glv_id   enum_id;        // First <enum> of that name, GLV_NONE otherwise
+  glv_id   feature;
+  glv_id   extension;
+  glv_id   group;          // GLV_NONE unless it names an enum group
+  uint32_t first_action;   // (feature, verb, profile) records, sorted by verb then feature order
+  uint32_t num_actions;
+  uint32_t first_provider; // Providing extensions, in registry order
+  uint32_t num_providers;
+  uint32_t first_group;    // Enum groups the name belongs to, in name_groups
+  uint32_t num_groups;
+};
+
+struct glv_command_rec {
+  glv_id   name;
+  glv_id   alias;          // Name of the <alias> target, GLV_NONE if there is none
+  glv_id   alias_class;    // GLV_NONE unless aliased in either direction
+  uint32_t first_param;
+  uint32_t num_params;
+  glv_str  proto;          // Return type exactly as declared, e.g. "const GLubyte *"
+  glv_str  ptype;          // Return <ptype>, if any
+};
+
+struct glv_param_rec {
+  glv_str  type;           // Everything before the name, e.g. "const GLchar *const*"
+  glv_str  ptype;
+  glv_str  name;
+};
+
+enum glv_enum_flags {
+  GLV_ENUM_ULL = 0x1       // type="ull"
+};
+
+// One <type>; a name may have a generic definition and API specific ones
+struct glv_type_rec {
+  glv_id   name;
+  glv_str  api;            // Empty unless the definition is API specific
+  glv_str  text;           // The C declaration, tags stripped and entities decoded
+  glv_id   required_type;  // Name of the type it needs declared first, GLV_NONE if none
+};
+
+struct glv_enum_rec {
+  uint64_t value;
+  glv_id   name;
+  glv_id   alias;          // Name its alias= attribute gives, GLV_NONE if none
+  uint32_t flags;
+  glv_str  api;            // Empty unless the value is API specific
+};
+
+struct glv_feature_rec {
+  glv_id   name;
+  glv_str  api;
+  glv_str  number;
+  uint32_t first_set;      // Its <require> and <remove> blocks in feature_sets, requires first
+  uint32_t num_sets;
+};
+
+// Every name a feature's <require> or <remove> blocks for one profile list, as a bitset over name ids
+struct glv_feature_set_rec {
+  uint32_t verb;           // GLV_REQUIRE or GLV_REMOVE
+  glv_str  profile;        // Empty unless the blocks name one
+  uint32_t first_word;     // set_words (db) words in feature_words
+};
+
+struct glv_extension_rec {
+  glv_id   name;
+  uint32_t supported;      // glv_api_bits
+};
+
+struct glv_action_rec {
+  glv_id   feature;
+  uint32_t verb;           // glv_verb
+  glv_str  profile;        // Empty unless the <require>/<deprecate>/<remove> block names one
+};
+
+struct glv_provider_rec {
+  glv_id   extension;
+  uint32_t apis;           // glv_api_bits the name is provided on
+};
+
+// An enum group, from <groups>, an <enums group=...> block, or <enum group=...> attributes
+struct glv_group_rec {
+  glv_str  name;
+  uint32_t flags;          // GLV_GROUP_*
+  uint32_t first_member;   // Enum names in group_members, in registry order
+  uint32_t num_members;
+  uint32_t first_bit;      // Bitmask groups: 64 entries in group_bits naming each single bit, GLV_NONE otherwise
+};
+
+const uint32_t GLV_GROUP_BITMASK = 1; // Declared by an <enums type="bitmask"> block
+
+// Commands connected by <alias name=...> in either direction
+struct glv_alias_rec {
+  glv_id   canonical;      // The member that is not itself an alias
+  uint32_t first_member;   // Command ids in alias_members, in registry order
+  uint32_t num_members;
+};
+
+template <typename T>
+struct glv_table {
+  const T* data;
+  uint32_t count;
+
+  const T& operator [] (uint32_t idx) const { return data [idx]; }
+};
+
+// Every table in the database, in snapshot order
+#define GLV_DB_TABLES(X)                   \
+  X (char,                 strings)        \
+  X (glv_name_rec,         names)          \
+  X (glv_command_rec,      commands)       \
+  X (glv_param_rec,        params)         \
+  X (glv_type_rec,         types)          \
+  X (glv_enum_rec,         enums)          \
+  X (glv_feature_rec,      features)       \
+  X (glv_extension_rec,    extensions)     \
+  X (glv_action_rec,       actions)        \
+  X (glv_feature_set_rec,  feature_sets)   \
+  X (uint64_t,             feature_words)  \
+  X (glv_provider_rec,     providers)      \
+  X (glv_alias_rec,        alias_classes)  \
+  X (glv_id,               alias_members)  \
+  X (glv_group_rec,        groups)         \
+  X (glv_id,               group_members)  \
+  X (glv_id,               name_groups)    \
+  X (glv_id,               group_bits)     \
+  X (glv_id,               enums_by_value) \
+  X (glv_id,               names_sorted)   \
+  X (uint32_t,             hash_seeds)     \
+  X (glv_id,               hash_slots)
+
+#define GLV_DB_COUNT_TABLE(type, table) + 1
+const uint32_t glv_db_num_tables = 0 GLV_DB_TABLES (GLV_DB_COUNT_TABLE);
+#undef GLV_DB_COUNT_TABLE
+
+struct glv_db {
+#define GLV_DB_DECLARE_TABLE(type, table) glv_table <type> table;
+  GLV_DB_TABLES (GLV_DB_DECLARE_TABLE)
+#undef GLV_DB_DECLARE_TABLE
+
+  std::string_view str (glv_str text) const
+  {
+    return std::string_view (strings.data + text.offset, text.length);
+  }
+
+  std::string_view name (glv_id id) const
+  {
+    return str (names [id].text);
+  }
+};
+
+// FNV-1a; also the base hash the perfect hash displaces from
+uint64_t hash_name (std::string_view name)
+{
+  uint64_t hash = 0xCBF29CE484222325ull;
+
+  for (size_t i = 0; i < name.size (); i++)
+    hash = (hash ^ (uint8_t)name [i]) * 0x100000001B3ull;
+
+  return hash;
+}
+
+uint32_t hash_bucket (uint64_t hash, uint32_t num_buckets)
+{
+  return (uint32_t)(hash >> 32) % num_buckets;
+}
+
+uint32_t hash_slot (uint64_t hash, uint32_t seed, uint32_t num_slots)
+{
+  uint64_t mixed = hash ^ (seed * 0x9E3779B97F4A7C15ull);
+  mixed ^= mixed >> 33;
+  mixed *= 0xFF51AFD7ED558CCDull;
+  mixed ^= mixed >> 33;
+  mixed *= 0xC4CEB9FE1A85EC53ull;
+  mixed ^= mixed >> 33;
+
+  return (uint32_t)(mixed % num_slots);
+}
+
+// One probe into the perfect hash, one comparison to reject names that are not in the registry
+glv_id find_name (const glv_db& db, std::string_view name)
+{
+  if (db.hash_slots.count == 0)
+    return GLV_NONE;
+
+  const uint64_t hash = hash_name (name);
+  const glv_id   id   = db.hash_slots [hash_slot (hash, db.hash_seeds [hash_bucket (hash, db.hash_seeds.count)], db.hash_slots.count)];
+
+  if (id != GLV_NONE && db.name (id) == name)
+    return id;
+
+  return GLV_NONE;
+}
+
+glv_id find_command (const glv_db& db, std::string_view name)
+{
+  const glv_id id = find_name (db, name);
+  return id != GLV_NONE ? db.names [id].command : GLV_NONE;
+}
+
+glv_id find_enum (const glv_db& db, std::string_view name)
+{
+  const glv_id id = find_name (db, name);
+  return id != GLV_NONE ? db.names [id].enum_id : GLV_NONE;
+}
+
+// Every enum sharing a value, across all <enums> blocks (does not use the alias XML attribute)
+glv_table <glv_id> find_enums_by_value (const glv_db& db, unsigned long long value)
+{
+  const glv_id* const first = db.enums_by_value.data;
+  const glv_id* const last  = db.enums_by_value.data + db.enums_by_value.count;
+
+  const glv_id* lower = std::lower_bound (first, last, value, [&db](glv_id id, unsigned long long v) { return db.enums [id].value < v; });
+  const glv_id* upper = std::upper_bound (lower, last, value, [&db](unsigned long long v, glv_id id) { return v < db.enums [id].value; });
+
+  glv_table <glv_id> range = { lower, (uint32_t)(upper - lower) };
+  return range;
+}
+
+glv_table <glv_action_rec> find_actions (const glv_db& db, glv_id name)
+{
+  const glv_name_rec& record = db.names [name];
+
+  glv_table <glv_action_rec> actions = { db.actions.data + record.first_action, record.num_actions };
+  return actions;
+}
+
+glv_table <glv_provider_rec> find_ext_reqs (const glv_db& db, glv_id name)
+{
+  const glv_name_rec& record = db.names [name];
+
+  glv_table <glv_provider_rec> providers = { db.providers.data + record.first_provider, record.num_providers };
+  return providers;
+}
+
+// Commands, enums, extensions and features; names that only appear in <require> lists (types) are not
+bool is_named_entity (const glv_db& db, glv_id name)
+{
+  const glv_name_rec& record = db.names [name];
+
+  return record.command   != GLV_NONE || record.enum_id != GLV_NONE ||
+         record.extension != GLV_NONE || record.feature != GLV_NONE;
+}
+
+// Every name starting with prefix, as a run of names_sorted
+glv_table <glv_id> find_names_by_prefix (const glv_db& db, std::string_view prefix)
+{
+  const glv_id* const first = db.names_sorted.data;
+  const glv_id* const last  = db.names_sorted.data + db.names_sorted.count;
+
+  const glv_id* lower = std::lower_bound (first, last, prefix, [&db](glv_id id, std::string_view p) { return db.name (id) < p; });
+  const glv_id* upper = std::upper_bound (lower, last, prefix, [&db](std::string_view p, glv_id id) { return p < db.name (id).substr (0, p.size ()); });
+
+  glv_table <glv_id> range = { lower, (uint32_t)(upper - lower) };
+  return range;
+}
+
+glv_table <glv_id> find_groups (const glv_db& db, glv_id name)
+{
+  const glv_name_rec& record = db.names [name];
+
+  glv_table <glv_id> groups = { db.name_groups.data + record.first_group, record.num_groups };
+  return groups;
+}
+
+// GLV_NONE if there is no group of that name
+glv_id find_group (const glv_db& db, std::string_view name)
+{
+  const glv_id id = find_name (db, name);
+  return id != GLV_NONE ? db.names [id].group : GLV_NONE;
+}
+
+uint32_t count_bits (uint64_t value)
+{
+  uint32_t count = 0;
+  for (; value != 0; value &= value - 1)
+    ++count;
+
+  return count;
+}
+
+// Members of a group whose value is exactly value, e.g. GL_ALL_ATTRIB_BITS for 0xFFFFFFFF
+std::vector <glv_id> find_group_members (const glv_db& db, glv_id group, uint64_t value)
+{
+  const glv_group_rec& record = db.groups [group];
+  std::vector <glv_id> members;
+
+  for (uint32_t i = 0; i < record.num_members; i++) {
+    const glv_id name    = db.group_members [record.first_member + i];
+    const glv_id enum_id = db.names [name].enum_id;
+
+    if (enum_id != GLV_NONE && db.enums [enum_id].value == value)
+      members.push_back (name);
+  }
+
+  return members;
+}
+
+// The named bits of value in a bitmask group; bits no member names are left in unknown
+std::vector <glv_id> decode_bits (const glv_db& db, glv_id group, uint64_t value, uint64_t& unknown)
+{
+  const glv_id* const  bits = db.group_bits.data + db.groups [group].first_bit;
+  std::vector <glv_id> names;
+
+  unknown = 0;
+
+  for (uint64_t rest = value; rest != 0; rest &= rest - 1) {
+    uint32_t bit = 0;
+    while (! ((rest >> bit) & 1))
+      ++bit;
+
+    if (bits [bit] != GLV_NONE)
+      names.push_back (bits [bit]);
+    else
+      unknown |= 1ull << bit;
+  }
+
+  return names;
+}
+
+// Every command equivalent to command (itself included), or NULL if it has no aliases
+const glv_alias_rec* find_command_aliases (const glv_db& db, glv_id command)
+{
+  const glv_id alias_class = db.commands [command].alias_class;
+
+  return alias_class != GLV_NONE ? &db.alias_classes [alias_class] : NULL;
+}
+
+// Words in each feature set; one bit per name id
+uint32_t set_words (const glv_db& db)
+{
+  return (db.names.count + 63) / 64;
+}
+
+// Whether any feature block names profile; the empty profile always exists
+bool is_known_profile (const glv_db& db, std::string_view profile)
+{
+  bool known = profile.empty ();
+  for (uint32_t i = 0; i < db.feature_sets.count && (! known); i++)
+    known = db.str (db.feature_sets [i].profile) == profile;
+
+  return known;
+}
+
+// Every name api's features up to version make available to profile, as a bitset over name ids. Features
+//   apply in registry order, each adding its requires and then taking away its removes, so a name removed
+//   from the core profile and required again later (GL_STACK_OVERFLOW in 4.3) ends up available. A block
+//   that names a profile only applies to that profile; with no profile, every require applies and no remove
+//   does. Returns how many features were applied.
+uint32_t find_available (const glv_db& db, std::string_view api, double version, std::string_view profile,
+                         std::vector <uint64_t>& available)
+{
+  const uint32_t num_words    = set_words (db);
+  uint32_t       num_features = 0;
+
+  available.assign (num_words, 0);
+  uint64_t* const words = available.data ();
+
+  for (glv_id i = 0; i < db.features.count; i++) {
+    const glv_feature_rec& feature = db.features [i];
+    if (db.str (feature.api) != api || parse_version (db.str (feature.number)) > version)
+      continue;
+
+    for (uint32_t j = 0; j < feature.num_sets; j++) {
+      const glv_feature_set_rec& set     = db.feature_sets [feature.first_set + j];
+      const std::string_view     applies = db.str (set.profile);
+      const uint64_t* const      bits    = db.feature_words.data + set.first_word;
+
+      if (set.verb == GLV_REQUIRE && (applies.empty () || profile.empty () || applies == profile)) {
+        for (uint32_t w = 0; w < num_words; w++)
+          words [w] |= bits [w];
+      } else if (set.verb == GLV_REMOVE && (applies.empty () || applies == profile)) {
+        for (uint32_t w = 0; w < num_words; w++)
+          words [w] &= ~bits [w];
+      }
+    }
+
+    ++num_features;
+  }
+
+  return num_features;
+}
+
+// A registry name close to one that was not found
+struct glv_suggestion {
+  glv_id   name;
+  uint32_t distance;       // Edits between the two, ignoring case (so glactivetexture finds glActiveTexture)
+};
+
+const uint32_t glv_max_suggestions = 5;
+
+// Myers' bit-parallel edit distance (Hyyrö's global formulation): one word of state per text character
+//   instead of a row of the DP matrix. pattern_eq holds, per byte, the bit set of pattern positions
+//   it matches. Gives up early once the distance cannot come back under max_distance.
+uint32_t myers_distance (const uint64_t* pattern_eq, uint32_t pattern_len, std::string_view text, uint32_t max_distance)
+{
+  const uint64_t high  = 1ull << (pattern_len - 1);
+  uint64_t       pv    = pattern_len == 64 ? ~0ull : (1ull << pattern_len) - 1;
+  uint64_t       mv    = 0;
+  uint32_t       score = pattern_len;
+
+  for (size_t j = 0; j < text.size (); j++) {
+    const uint64_t eq = pattern_eq [(uint8_t)tolower ((uint8_t)text [j])];
+    const uint64_t xv = eq | mv;
+    const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+
+    uint64_t ph = mv | ~(xh | pv);
+    uint64_t mh = pv & xh;
+
+    if (ph & high)
+      ++score;
+    else if (mh & high)
+      --score;
+
+    // Row 0 is the distance from the empty pattern, so it grows by one per text character
+    ph = (ph << 1) | 1;
+    mh =  mh << 1;
+
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+
+    // Each remaining character can lower the score by at most one
+    if (score > max_distance + (text.size () - j - 1))
+      return max_distance + 1;
+  }
+
+  return score;
+}
+
+// Folds case (and, harmlessly, a few other characters) together
+uint32_t bag_class (char c)
+{
+  return ((uint8_t)c | 0x20) & 63;
+}
+
+// A lower bound on the edit distance from character counts alone: each character one string has more of
+//   than the other costs at least one edit. Much cheaper than the distance itself, so it runs first.
+uint32_t bag_distance (const int32_t* pattern_counts, std::string_view text)
+{
+  int32_t counts [64];
+  memcpy (counts, pattern_counts, sizeof (counts));
+
+  for (size_t j = 0; j < text.size (); j++)
+    --counts [bag_class (text [j])];
+
+  uint32_t missing = 0;
+  uint32_t extra   = 0;
+  for (uint32_t i = 0; i < 64; i++) {
+    if (counts [i] > 0)
+      missing += (uint32_t)counts [i];
+    else
+      extra   += (uint32_t)-counts [i];
+  }
+
+  return std::max (missing, extra);
+}
+
+// The plain dynamic program, for queries longer than one machine word
+uint32_t dp_distance (std::string_view pattern, std::string_view text)
+{
+  std::vector <uint32_t> row (pattern.size () + 1);
+  for (size_t i = 0; i <= pattern.size (); i++)
+    row [i] = (uint32_t)i;
+
+  for (size_t j = 0; j < text.size (); j++) {
+    uint32_t diagonal = row [0];
+    row [0] = (uint32_t)j + 1;
+
+    for (size_t i = 1; i <= pattern.size (); i++) {
+      const uint32_t above = row [i];
+      const uint32_t cost  = tolower ((uint8_t)pattern [i - 1]) == tolower ((uint8_t)text [j]) ? 0 : 1;
+
+      row [i]  = std::min (std::min (row [i - 1] + 1, above + 1), diagonal + cost);
+      diagonal = above;
+    }
+  }
+
+  return row [pattern.size ()];
+}
+
+// The closest command and enum names to one that was not found, nearest first; at most glv_max_suggestions,
+//   and none further than about a quarter of the name's length away
+std::vector <glv_suggestion> find_similar_names (const glv_db& db, std::string_view name)
+{
+  std::vector <glv_suggestion> best;
+
+  if (name.empty ())
+    return best;
+
+  const uint32_t pattern_len  = (uint32_t)name.size ();
+  uint32_t       max_distance = std::min (pattern_len / 4 + 1, 4u);
+
+  int32_t pattern_counts [64] = { 0 };
+  for (uint32_t i = 0; i < pattern_len; i++)
+    ++pattern_counts [bag_class (name [i])];
+
+  uint64_t pattern_eq [256] = { 0 };
+  if (pattern_len <= 64) {
+    for (uint32_t i = 0; i < pattern_len; i++)
+      pattern_eq [(uint8_t)tolower ((uint8_t)name [i])] |= 1ull << i;
+  }
+
+  for (glv_id id = 0; id < db.names.count; id++) {
+    const glv_name_rec& record = db.names [id];
+    if (record.command == GLV_NONE && record.enum_id == GLV_NONE)
+      continue;
+
+    // The length difference alone is a lower bound on the distance
+    const uint32_t text_len = record.text.length;
+    if ((text_len > pattern_len ? text_len - pattern_len : pattern_len - text_len) > max_distance)
+      continue;
+
+    const std::string_view text = db.name (id);
+    if (bag_distance (pattern_counts, text) > max_distance)
+      continue;
+
+    const uint32_t distance = pattern_len <= 64 ? myers_distance (pattern_eq, pattern_len, text, max_distance) :
+                                                  dp_distance    (name, text);
+    if (distance > max_distance)
+      continue;
+
+    glv_suggestion suggestion = { id, distance };
+    best.insert (std::upper_bound (best.begin (), best.end (), suggestion,
+                                   [&db](const glv_suggestion& a, const glv_suggestion& b) {
+                                     return a.distance < b.distance || (a.distance == b.distance && db.name (a.name) < db.name (b.name));
+                                   }), suggestion);
+
+    // Once the list is full, nothing further away than its last entry can still get in
+    if (best.size () > glv_max_suggestions)
+      best.pop_back ();
+    if (best.size () == glv_max_suggestions)
+      max_distance = best.back ().distance;
+  }
+
+  return best;
+}
+
+
+//
+// Patterns
+//
+//   "/GL_.*_ARB$/" is a regular expression searched for anywhere in a name, and "glUniform*fv" is a glob
+//     matched against the whole name. Both compile to a Thompson NFA that runs as a lazily built DFA, so
+//     every name costs one table lookup per character however the pattern is written.
+//
+//   Regular expressions have literals, '.', [classes] with ranges and '^' negation, \d \w \s, escaped
+//     punctuation, (groups), '|', '*', '+', '?', and the anchors '^' and '$'.
+//
+enum glv_nfa_op {
+  GLV_NFA_BYTES,           // Consumes one byte that is in the set
+  GLV_NFA_SPLIT,           // Continues at both out and out1
+  GLV_NFA_EMPTY,
+  GLV_NFA_BOL,             // Passable only before the first byte
+  GLV_NFA_EOL,             // Passable only after the last byte
+  GLV_NFA_MATCH
+};
+
+struct glv_nfa_state {
+  glv_nfa_op op;
+  uint32_t   out;
+  uint32_t   out1;
+  uint64_t   bytes [4];
+};
+
+struct glv_regex {
+  std::vector <glv_nfa_state> states;
+  uint32_t                    start;
+};
+
+// A piece of NFA under construction: where it starts, and the exits still waiting for a target
+//   (state * 2, or state * 2 + 1 for out1)
+struct glv_nfa_frag {
+  uint32_t               start;
+  std::vector <uint32_t> exits;
+};
+
+struct glv_regex_parser {
+  std::string_view pattern;
+  size_t           pos;
+  uint32_t         depth;
+  glv_regex&       regex;
+  std::string      error;
+
+  bool at_end (void) const { return pos >= pattern.size (); }
+  char peek   (void) const { return pattern [pos]; }
+};
+
+uint32_t add_nfa_state (glv_regex& regex, glv_nfa_op op)
+{
+  glv_nfa_state state;
+  state.op   = op;
+  state.out  = GLV_NONE;
+  state.out1 = GLV_NONE;
+  memset (state.bytes, 0, sizeof (state.bytes));
+
+  regex.states.push_back (state);
+  return (uint32_t)regex.states.size () - 1;
+}
+
+void add_nfa_byte (glv_nfa_state& state, uint8_t c)
+{
+  state.bytes [c >> 6] |= 1ull << (c & 63);
+}
+
+bool has_nfa_byte (const glv_nfa_state& state, uint8_t c)
+{
+  return (state.bytes [c >> 6] >> (c & 63)) & 1;
+}
+
+void patch_nfa_exits (glv_regex& regex, const std::vector <uint32_t>& exits, uint32_t target)
+{
+  for (size_t i = 0; i < exits.size (); i++) {
+    if (exits [i] & 1)
+      regex.states [exits [i] >> 1].out1 = target;
+    else
+      regex.states [exits [i] >> 1].out  = target;
+  }
+}
+
+glv_nfa_frag nfa_fragment (uint32_t state)
+{
+  glv_nfa_frag frag;
+  frag.start = state;
+  frag.exits.push_back (state * 2);
+  return frag;
+}
+
+// The bytes an escape like \d stands for; anything else escapes itself
+void add_escaped_bytes (glv_nfa_state& state, char c)
+{
+  switch (c) {
+    case 'd':
+      for (int b = '0'; b <= '9'; b++) add_nfa_byte (state, (uint8_t)b);
+      break;
+    case 'w':
+      for (int b = 0; b < 256; b++) {
+        if (isalnum (b) || b == '_')
+          add_nfa_byte (state, (uint8_t)b);
+      }
+      break;
+    case 's':
+      for (const char* b = " \t\r\n\f\v"; *b != '\0'; b++) add_nfa_byte (state, (uint8_t)*b);
+      break;
+    default:
+      add_nfa_byte (state, (uint8_t)c);
+      break;
+  }
+}
+
+bool parse_regex_class (glv_regex_parser& parser, glv_nfa_state& state)
+{
+  glv_nfa_state members;
+  memset (members.bytes, 0, sizeof (members.bytes));
+
+  const bool negated = (! parser.at_end ()) && parser.peek () == '^';
+  if (negated)
+    ++parser.pos;
+
+  // A ']' straight after the '[' (or '[^') is a member, not the end
+  for (bool first = true; ; first = false) {
+    if (parser.at_end ()) {
+      parser.error = "unterminated [class]";
+      return false;
+    }
+
+    char c = parser.pattern [parser.pos++];
+    if (c == ']' && (! first))
+      break;
+
+    if (c == '\\' && (! parser.at_end ())) {
+      add_escaped_bytes (members, parser.pattern [parser.pos++]);
+      continue;
+    }
+
+    if (parser.pos + 1 < parser.pattern.size () && parser.peek () == '-' && parser.pattern [parser.pos + 1] != ']') {
+      const char last = parser.pattern [parser.pos + 1];
+      parser.pos += 2;
+      for (int b = (uint8_t)c; b <= (uint8_t)last; b++)
+        add_nfa_byte (members, (uint8_t)b);
+      continue;
+    }
+
+    add_nfa_byte (members, (uint8_t)c);
+  }
+
+  for (int i = 0; i < 4; i++)
+    state.bytes [i] = negated ? ~members.bytes [i] : members.bytes [i];
+
+  return true;
+}
+
+bool parse_regex_alternation (glv_regex_parser& parser, glv_nfa_frag& frag);
+
+bool parse_regex_atom (glv_regex_parser& parser, glv_nfa_frag& frag)
+{
+  glv_regex& regex = parser.regex;
+  const char c     = parser.pattern [parser.pos++];
+
+  switch (c) {
+    case '(':
+      if (++parser.depth > 256) {
+        parser.error = "groups nested too deeply";
+        return false;
+      }
+      if (! parse_regex_alternation (parser, frag))
+        return false;
+      if (parser.at_end () || parser.peek () != ')') {
+        parser.error = "unmatched '('";
+        return false;
+      }
+      ++parser.pos;
+      --parser.depth;
+      return true;
+
+    case '^':
+      frag = nfa_fragment (add_nfa_state (regex, GLV_NFA_BOL));
+      return true;
+
+    case '$':
+      frag = nfa_fragment (add_nfa_state (regex, GLV_NFA_EOL));
+      return true;
+
+    case '*': case '+': case '?':
+      parser.error = std::string ("nothing to repeat before '") + c + "'";
+      return false;
+  }
+
+  const uint32_t state = add_nfa_state (regex, GLV_NFA_BYTES);
+
+  if (c == '.') {
+    memset (regex.states [state].bytes, 0xFF, sizeof (regex.states [state].bytes));
+  } else if (c == '[') {
+    if (! parse_regex_class (parser, regex.states [state]))
+      return false;
+  } else if (c == '\\') {
+    if (parser.at_end ()) {
+      parser.error = "trailing '\\'";
+      return false;
+    }
+    add_escaped_bytes (regex.states [state], parser.pattern [parser.pos++]);
+  } else {
+    add_nfa_byte (regex.states [state], (uint8_t)c);
+  }
+
+  frag = nfa_fragment (state);
+  return true;
+}
+
+bool parse_regex_repeat (glv_regex_parser& parser, glv_nfa_frag& frag)
+{
+  if (! parse_regex_atom (parser, frag))
+    return false;
+
+  glv_regex& regex = parser.regex;
+
+  while ((! parser.at_end ()) && (parser.peek () == '*' || parser.peek () == '+' || parser.peek () == '?')) {
+    const char     op    = parser.pattern [parser.pos++];
+    const uint32_t split = add_nfa_state (regex, GLV_NFA_SPLIT);
+
+    regex.states [split].out = frag.start;
+
+    if (op == '*') {
+      patch_nfa_exits (regex, frag.exits, split);
+      frag.start = split;
+      frag.exits.assign (1, split * 2 + 1);
+    } else if (op == '+') {
+      patch_nfa_exits (regex, frag.exits, split);
+      frag.exits.assign (1, split * 2 + 1);
+    } else {
+      frag.start = split;
+      frag.exits.push_back (split * 2 + 1);
+    }
+  }
+
+  return true;
+}
+
+bool parse_regex_concatenation (glv_regex_parser& parser, glv_nfa_frag& frag)
+{
+  frag = nfa_fragment (add_nfa_state (parser.regex, GLV_NFA_EMPTY));
+
+  while ((! parser.at_end ()) && parser.peek () != '|' && parser.peek () != ')') {
+    glv_nfa_frag next;
+    if (! parse_regex_repeat (parser, next))
+      return false;
+
+    patch_nfa_exits (parser.regex, frag.exits, next.start);
+    frag.exits.swap (next.exits);
+  }
+
+  return true;
+}
+
+bool parse_regex_alternation (glv_regex_parser& parser, glv_nfa_frag& frag)
+{
+  if (! parse_regex_concatenation (parser, frag))
+    return false;
+
+  while ((! parser.at_end ()) && parser.peek () == '|') {
+    ++parser.pos;
+
+    glv_nfa_frag other;
+    if (! parse_regex_concatenation (parser, other))
+      return false;
+
+    const uint32_t split = add_nfa_state (parser.regex, GLV_NFA_SPLIT);
+    parser.regex.states [split].out  = frag.start;
+    parser.regex.states [split].out1 = other.start;
+
+    frag.start = split;
+    frag.exits.insert (frag.exits.end (), other.exits.begin (), other.exits.end ());
+  }
+
+  return true;
+}
+
+// Compiles an unanchored search for pattern; error says what is wrong with it otherwise
+bool compile_regex (std::string_view pattern, glv_regex& regex, std::string& error)
+{
+  glv_regex_parser parser = { pattern, 0, 0, regex, std::string () };
+  glv_nfa_frag     frag;
+
+  regex.states.clear ();
+
+  if (! parse_regex_alternation (parser, frag)) {
+    error = parser.error;
+    return false;
+  }
+
+  if (! parser.at_end ()) {
+    error = "unmatched ')'";
+    return false;
+  }
+
+  patch_nfa_exits (regex, frag.exits, add_nfa_state (regex, GLV_NFA_MATCH));
+
+  // A leading loop over any byte lets a match start anywhere; MATCH is checked as soon as it is reached, so
+  //   a match may end anywhere too
+  const uint32_t any  = add_nfa_state (regex, GLV_NFA_BYTES);
+  const uint32_t loop = add_nfa_state (regex, GLV_NFA_SPLIT);
+
+  memset (regex.states [any].bytes, 0xFF, sizeof (regex.states [any].bytes));
+  regex.states [any].out   = loop;
+  regex.states [loop].out  = frag.start;
+  regex.states [loop].out1 = any;
+  regex.start              = loop;
+
+  return true;
+}
+
+// "glUniform*fv" -> "^glUniform.*fv$"
+std::string glob_to_regex (std::string_view glob)
+{
+  std::string regex ("^");
+
+  for (size_t i = 0; i < glob.size (); i++) {
+    const char c = glob [i];
+
+    if (c == '*')
+      regex += ".*";
+    else if (c == '?')
+      regex += '.';
+    else if (c == '[') {
+      const size_t close = glob.find (']', i + 2);
+      if (close == std::string_view::npos) {
+        regex += "\\[";
+      } else {
+        regex += '[';
+        regex += glob [i + 1] == '!' ? std::string ("^") + std::string (glob.substr (i + 2, close - i - 2)) :
+                                       std::string (glob.substr (i + 1, close - i - 1));
+        regex += ']';
+        i = close;
+      }
+    } else {
+      if (strchr ("\\.+()|^$", c) != NULL)
+        regex += '\\';
+      regex += c;
+    }
+  }
+
+  return regex + "$";
+}
+
+// DFA state flags
+const uint8_t glv_dfa_matched        = 1; // MATCH has been reached, whatever follows
+const uint8_t glv_dfa_matches_at_end = 2; // MATCH is reachable if the name ends here
+const uint8_t glv_dfa_dead           = 4; // Nothing can match any more
+
+// Past this many states the cache starts over, which bounds memory on patterns whose DFA would be huge
+const uint32_t glv_dfa_max_states = 4096;
+
+// States are built on first use, so a scan never pays for the parts of the subset construction it does
+//   not reach. Not shareable: each thread scans with its own.
+struct glv_dfa {
+  const glv_regex*                               regex;
+  std::vector <std::vector <uint32_t> >          sets;  // Sorted NFA states behind each DFA state
+  std::map <std::vector <uint32_t>, uint32_t>    ids;
+  std::vector <int32_t>                          next;  // 256 per state, -1 until computed
+  std::vector <uint8_t>                          flags;
+  uint32_t                                       start;
+  std::vector <uint8_t>                          seen;  // Scratch for closures
+};
+
+// Follows empty moves from state, collecting the states that consume bytes or wait for the end (and MATCH)
+void add_nfa_closure (const glv_regex& regex, uint32_t state, bool at_start, bool at_end,
+                      std::vector <uint8_t>& seen, std::vector <uint32_t>& set)
+{
+  std::vector <uint32_t> stack (1, state);
+
+  while (! stack.empty ()) {
+    const uint32_t s = stack.back ();
+    stack.pop_back ();
+
+    if (s == GLV_NONE || seen [s])
+      continue;
+    seen [s] = 1;
+
+    const glv_nfa_state& nfa = regex.states [s];
+    switch (nfa.op) {
+      case GLV_NFA_SPLIT:
+        stack.push_back (nfa.out1);
+        stack.push_back (nfa.out);
+        break;
+      case GLV_NFA_EMPTY:
+        stack.push_back (nfa.out);
+        break;
+      case GLV_NFA_BOL:
+        if (at_start)
+          stack.push_back (nfa.out);
+        break;
+      case GLV_NFA_EOL:
+        if (at_end)
+          stack.push_back (nfa.out);
+        else
+          set.push_back (s);
+        break;
+      case GLV_NFA_BYTES:
+      case GLV_NFA_MATCH:
+        set.push_back (s);
+        break;
+    }
+  }
+}
+
+uint32_t dfa_state (glv_dfa& dfa, std::vector <uint32_t>& set)
+{
+  std::sort (set.begin (), set.end ());
+
+  std::map <std::vector <uint32_t>, uint32_t>::const_iterator existing = dfa.ids.find (set);
+  if (existing != dfa.ids.end ())
+    return existing->second;
+
+  const glv_regex& regex = *dfa.regex;
+  uint8_t          flags = set.empty () ? glv_dfa_dead : 0;
+
+  for (size_t i = 0; i < set.size (); i++) {
+    if (regex.states [set [i]].op == GLV_NFA_MATCH)
+      flags |= glv_dfa_matched | glv_dfa_matches_at_end;
+  }
+
+  if (! (flags & glv_dfa_matches_at_end)) {
+    std::vector <uint32_t> at_end;
+    std::fill (dfa.seen.begin (), dfa.seen.end (), 0);
+    for (size_t i = 0; i < set.size (); i++) {
+      if (regex.states [set [i]].op == GLV_NFA_EOL)
+        add_nfa_closure (regex, regex.states [set [i]].out, false, true, dfa.seen, at_end);
+    }
+    for (size_t i = 0; i < at_end.size (); i++) {
+      if (regex.states [at_end [i]].op == GLV_NFA_MATCH)
+        flags |= glv_dfa_matches_at_end;
+    }
+  }
+
+  const uint32_t id = (uint32_t)dfa.sets.size ();
+  dfa.sets.push_back   (set);
+  dfa.ids.emplace      (set, id);
+  dfa.flags.push_back  (flags);
+  dfa.next.insert      (dfa.next.end (), 256, -1);
+
+  return id;
+}
+
+void reset_dfa (glv_dfa& dfa)
+{
+  dfa.sets.clear  ();
+  dfa.ids.clear   ();
+  dfa.next.clear  ();
+  dfa.flags.clear ();
+
+  std::vector <uint32_t> set;
+  std::fill (dfa.seen.begin (), dfa.seen.end (), 0);
+  add_nfa_closure (*dfa.regex, dfa.regex->start, true, false, dfa.seen, set);
+
+  dfa.start = dfa_state (dfa, set);
+}
+
+void init_dfa (glv_dfa& dfa, const glv_regex& regex)
+{
+  dfa.regex = &regex;
+  dfa.seen.assign (regex.states.size (), 0);
+
+  reset_dfa (dfa);
+}
+
+uint32_t dfa_step (glv_dfa& dfa, uint32_t state, uint8_t c)
+{
+  const int32_t cached = dfa.next [state * 256 + c];
+  if (cached >= 0)
+    return (uint32_t)cached;
+
+  const glv_regex&       regex = *dfa.regex;
+  std::vector <uint32_t> set;
+
+  std::fill (dfa.seen.begin (), dfa.seen.end (), 0);
+  for (size_t i = 0; i < dfa.sets [state].size (); i++) {
+    const glv_nfa_state& nfa = regex.states [dfa.sets [state][i]];
+    if (nfa.op == GLV_NFA_BYTES && has_nfa_byte (nfa, c))
+      add_nfa_closure (regex, nfa.out, false, false, dfa.seen, set);
+  }
+
+  if (dfa.sets.size () >= glv_dfa_max_states) {
+    reset_dfa (dfa);
+    return dfa_state (dfa, set);
+  }
+
+  const uint32_t next = dfa_state (dfa, set);
+  dfa.next [state * 256 + c] = (int32_t)next;
+
+  return next;
+}
+
+bool dfa_matches (glv_dfa& dfa, std::string_view text)
+{
+  uint32_t state = dfa.start;
+
+  for (size_t i = 0; i < text.size (); i++) {
+    if (dfa.flags [state] & (glv_dfa_matched | glv_dfa_dead))
+      break;
+    state = dfa_step (dfa, state, (uint8_t)text [i]);
+  }
+
+  return (dfa.flags [state] & glv_dfa_matches_at_end) != 0;
+}
+
+// Names per scanning thread; below this, starting a thread costs more than it saves
+const uint32_t glv_match_chunk_names = 16384;
+
+// Every command, enum, extension and feature whose name the pattern matches, in name order. One pass over the
+//   names whatever the pattern; large registries are split into contiguous runs scanned on separate threads.
+std::vector <glv_id> find_matching_names (const glv_db& db, const glv_regex& regex)
+{
+  const uint32_t num_names   = db.names_sorted.count;
+  const unsigned num_threads = std::max (1u, std::min (std::thread::hardware_concurrency (), num_names / glv_match_chunk_names));
+
+  std::vector <std::vector <glv_id> > found (num_threads);
+
+  auto scan = [&db, &regex, &found, num_names, num_threads] (unsigned t) {
+    glv_dfa dfa;
+    init_dfa (dfa, regex);
+
+    const uint32_t first = (uint32_t)((uint64_t)num_names *  t      / num_threads);
+    const uint32_t last  = (uint32_t)((uint64_t)num_names * (t + 1) / num_threads);
+
+    for (uint32_t i = first; i < last; i++) {
+      const glv_id id = db.names_sorted [i];
+      if (is_named_entity (db, id) && dfa_matches (dfa, db.name (id)))
+        found [t].push_back (id);
+    }
+  };
+
+  std::vector <std::thread> workers;
+  for (unsigned t = 1; t < num_threads; t++)
+    workers.push_back (std::thread (scan, t));
+
+  scan (0);
+
+  for (size_t i = 0; i < workers.size (); i++)
+    workers [i].join ();
+
+  for (unsigned t = 1; t < num_threads; t++)
+    found [0].insert (found [0].end (), found [t].begin (), found [t].end ());
+
+  return found [0];
+}
+
+
+//
+// Building the database from gl.xml
+//
+struct glv_db_builder {
+#define GLV_DB_DECLARE_TABLE(type, table) std::vector <type> table;
+  GLV_DB_TABLES (GLV_DB_DECLARE_TABLE)
+#undef GLV_DB_DECLARE_TABLE
+
+  // Only needed while building; keyed by views into the parsed document
+  std::unordered_map <std::string_view, glv_id>  name_ids;
+  std::unordered_map <std::string,      glv_str> string_ids;
+
+  glv_db view (void) const
+  {
+    glv_db db;
+#define GLV_DB_VIEW_TABLE(type, table) db.table.data = table.data (); db.table.count = (uint32_t)table.size ();
+    GLV_DB_TABLES (GLV_DB_VIEW_TABLE)
+#undef GLV_DB_VIEW_TABLE
+    return db;
+  }
+};
+
+glv_str intern_string (glv_db_builder& db, std::string_view text)
+{
+  std::unordered_map <std::string, glv_str>::const_iterator existing = db.string_ids.find (std::string (text));
+  if (existing != db.string_ids.end ())
+    return existing->second;
+
+  glv_str str = { (uint32_t)db.strings.size (), (uint32_t)text.size () };
+
+  // Keep every string NUL terminated in the blob as well, it costs one byte and saves copies for C APIs
+  db.strings.insert (db.strings.end (), text.begin (), text.end ());
+  db.strings.push_back ('\0');
+
+  db.string_ids.emplace (std::string (text), str);
+  return str;
+}
+
+glv_id intern_name (glv_db_builder& db, std::string_view name)
+{
+  std::unordered_map <std::string_view, glv_id>::const_iterator existing = db.name_ids.find (name);
+  if (existing != db.name_ids.end ())
+    return existing->second;
+
+  glv_name_rec record;
+  record.text           = intern_string (db, name);
+  record.command        = GLV_NONE;
+  record.enum_id        = GLV_NONE;
+  record.feature        = GLV_NONE;
+  record.extension      = GLV_NONE;
+  record.group          = GLV_NONE;
+  record.first_action   = 0;
+  record.num_actions    = 0;
+  record.first_provider = 0;
+  record.num_providers  = 0;
+  record.first_group    = 0;
+  record.num_groups     = 0;
+
+  const glv_id id = (glv_id)db.names.size ();
+  db.names.push_back (record);
+  db.name_ids.emplace (name, id);
+  return id;
+}
+
+// A <type> as C: its source text with <name> tags dropped and <apientry/> spelled APIENTRY. Read from the
+//   source rather than the tree, since whitespace rapidxml drops between elements is significant here.
+std::string render_type (xml_node<>* node)
+{
+  const char* start = node->name () + node->name_size ();
+  bool        quoted = false;
+  while (*start != '\0' && (*start != '>' || quoted)) {
+    if (*start == '"')
+      quoted = ! quoted;
+    ++start;
+  }
+  if (*start == '\0' || start [-1] == '/')
+    return std::string ();
+
+  const char* end = strstr (++start, "</type>");
+  if (end == NULL)
+    return std::string ();
+
+  std::string text;
+  for (const char* c = start; c < end; ++c) {
+    if (*c != '<') {
+      text += *c;
+      continue;
+    }
+
+    const char* close = (const char*)memchr (c, '>', end - c);
+    if (close == NULL)
+      break;
+    if (std::string_view (c, close - c).substr (0, 9) == "<apientry")
+      text += "APIENTRY";
+    c = close;
+  }
+
+  return decode_entities (text);
+}
+
+// Text of node's children up to (not including) its <name>, e.g. "const GLubyte *" for a <proto>
+std::string render_declaration (xml_node<>* node)
+{
+  std::string text;
+
+  for (xml_node<>* child = node->first_node (); child != NULL; child = child->next_sibling ()) {
+    if (child->type () == node_element && xml_name (child) == "name")
+      break;
+    text.append (child->value (), child->value_size ());
+
+    // rapidxml drops whitespace-only text between two elements (e.g. "<ptype>GLenum</ptype> <name>"); the
+    //   source is unmodified, so look past the closing tag to put the separating space back
+    if (child->type () == node_element && child->next_sibling () != NULL && child->next_sibling ()->type () == node_element) {
+      const char* after = child->value () + child->value_size () + child->name_size () + 3;
+      if (*after == ' ' || *after == '\t' || *after == '\r' || *after == '\n')
+        text += ' ';
+    }
+  }
+
+  return text;
+}
+
+void build_features (glv_db_builder& db, xml_node<>* registry)
+{
+  xml_node<>* feature = registry->first_node ("feature");
+  while (feature != NULL) {
+    glv_feature_rec record;
+    record.name      = intern_name   (db, xml_attribute_value (feature, "name"));
+    record.api       = intern_string (db, xml_attribute_value (feature, "api"));
+    record.number    = intern_string (db, xml_attribute_value (feature, "number"));
+    record.first_set = 0;            // Filled in by build_feature_sets
+    record.num_sets  = 0;
+
+    db.names [record.name].feature = (glv_id)db.features.size ();
+    db.features.push_back (record);
+
+    feature = feature->next_sibling ("feature");
+  }
+}
+
+void build_commands (glv_db_builder& db, xml_node<>* registry)
+{
+  // Alias targets can only be resolved once every command has been named
+  std::vector <std::string_view> alias_targets;
+
+  xml_node<>* command = registry->first_node ("commands")->first_node ("command");
+  while (command != NULL) {
+    xml_node<>* proto = command->first_node ("proto");
+    xml_node<>* ptype = proto->first_node ("ptype");
+    xml_node<>* alias = command->first_node ("alias");
+
+    glv_command_rec record;
+    record.name        = intern_name   (db, xml_value (proto->first_node ("name")));
+    record.alias       = GLV_NONE;
+    record.alias_class = GLV_NONE;
+    record.first_param = (uint32_t)db.params.size ();
+    record.num_params  = 0;
+    record.proto       = intern_string (db, render_declaration (proto));
+    record.ptype       = intern_string (db, ptype != NULL ? xml_value (ptype) : std::string_view ());
+
+    xml_node<>* param = command->first_node ("param");
+    while (param != NULL) {
+      xml_node<>* param_type = param->first_node ("ptype");
+
+      glv_param_rec param_record;
+      param_record.type  = intern_string (db, render_declaration (param));
+      param_record.ptype = intern_string (db, param_type != NULL ? xml_value (param_type) : std::string_view ());
+      param_record.name  = intern_string (db, xml_value (param->first_node ("name")));
+
+      db.params.push_back (param_record);
+      ++record.num_params;
+
+      param = param->next_sibling ("param");
+    }
+
+    // First definition wins, matching the order the linear search used to report
+    if (db.names [record.name].command == GLV_NONE)
+      db.names [record.name].command = (glv_id)db.commands.size ();
+
+    alias_targets.push_back (alias != NULL ? xml_attribute_value (alias, "name") : std::string_view ());
+    db.commands.push_back (record);
+
+    command = command->next_sibling ("command");
+  }
+
+  for (size_t i = 0; i < db.commands.size (); i++) {
+    if (! alias_targets [i].empty ())
+      db.commands [i].alias = intern_name (db, alias_targets [i]);
+  }
+}
+
+void build_enums (glv_db_builder& db, xml_node<>* registry)
+{
+  xml_node<>* enum_group = registry->first_node ("enums");
+  while (enum_group != NULL) {
+    xml_node<>* enum_entry = enum_group->first_node ("enum");
+    while (enum_entry != NULL) {
+      glv_enum_rec record;
+      record.value = parse_enum_value (enum_entry);
+      record.name  = intern_name   (db, xml_attribute_value (enum_entry, "name"));
+      record.flags = xml_attribute_value (enum_entry, "type") == "ull" ? GLV_ENUM_ULL : 0;
+      record.api   = intern_string (db, xml_attribute_value (enum_entry, "api"));
+
+      const std::string_view alias = xml_attribute_value (enum_entry, "alias");
+      record.alias = alias.empty () ? GLV_NONE : intern_name (db, alias);
+
+      // Some names are defined once per API (e.g. GL_ACTIVE_PROGRAM_EXT), keep the first like find_enum always did
+      if (db.names [record.name].enum_id == GLV_NONE)
+        db.names [record.name].enum_id = (glv_id)db.enums.size ();
+
+      db.enums.push_back (record);
+
+      enum_entry = enum_entry->next_sibling ("enum");
+    }
+    enum_group = enum_group->next_sibling ("enums");
+  }
+
+  db.enums_by_value.resize (db.enums.size ());
+  for (size_t i = 0; i < db.enums_by_value.size (); i++)
+    db.enums_by_value [i] = (glv_id)i;
+
+  // Stable, so names sharing a value stay in document order
+  std::stable_sort (db.enums_by_value.begin (), db.enums_by_value.end (),
+                    [&db](glv_id a, glv_id b) { return db.enums [a].value < db.enums [b].value; });
+}
+
+void build_types (glv_db_builder& db, xml_node<>* registry)
+{
+  for (xml_node<>* types = registry->first_node ("types"); types != NULL; types = types->next_sibling ("types")) {
+    for (xml_node<>* type = types->first_node ("type"); type != NULL; type = type->next_sibling ("type")) {
+      std::string_view name = xml_attribute_value (type, "name");
+      if (name.empty () && type->first_node ("name") != NULL)
+        name = xml_value (type->first_node ("name"));
+      if (name.empty ())
+        continue;
+
+      const std::string_view required_type = xml_attribute_value (type, "requires");
+
+      glv_type_rec record;
+      record.name          = intern_name   (db, name);
+      record.api           = intern_string (db, xml_attribute_value (type, "api"));
+      record.text          = intern_string (db, render_type (type));
+      record.required_type = required_type.empty () ? GLV_NONE : intern_name (db, required_type);
+
+      db.types.push_back (record);
+    }
+  }
+}
+
+// Groups are declared three ways depending on the registry's vintage; all of them are merged here
+void build_groups (glv_db_builder& db, xml_node<>* registry)
+{
+  std::unordered_map <std::string_view, glv_id> group_ids;
+  std::vector <std::vector <glv_id> >           members;
+  std::vector <std::vector <glv_id> >           name_groups (db.names.size ());
+
+  auto add_member = [&] (std::string_view group, glv_id name, uint32_t flags) {
+    std::unordered_map <std::string_view, glv_id>::const_iterator existing = group_ids.find (group);
+
+    glv_id group_id;
+    if (existing != group_ids.end ()) {
+      group_id = existing->second;
+    } else {
+      glv_group_rec record;
+      record.name         = intern_string (db, group);
+      record.flags        = 0;
+      record.first_member = 0;
+      record.num_members  = 0;
+      record.first_bit    = GLV_NONE;
+
+      group_id = (glv_id)db.groups.size ();
+      db.groups.push_back (record);
+      members.resize      (db.groups.size ());
+      group_ids.emplace   (group, group_id);
+
+      // Interned as a name too, so VALUE:GROUP finds the group with the same hash probe as any other name
+      const glv_id name_id = intern_name (db, group);
+      db.names [name_id].group = group_id;
+    }
+
+    db.groups [group_id].flags |= flags;
+
+    if (name >= name_groups.size ())
+      name_groups.resize (name + 1);
+
+    // The same membership is often declared by more than one of the three sources
+    if (std::find (name_groups [name].begin (), name_groups [name].end (), group_id) == name_groups [name].end ()) {
+      name_groups [name].push_back (group_id);
+      members [group_id].push_back (name);
+    }
+  };
+
+  xml_node<>* groups = registry->first_node ("groups");
+  for (xml_node<>* group = groups != NULL ? groups->first_node ("group") : NULL; group != NULL; group = group->next_sibling ("group")) {
+    for (xml_node<>* entry = group->first_node ("enum"); entry != NULL; entry = entry->next_sibling ("enum"))
+      add_member (xml_attribute_value (group, "name"), intern_name (db, xml_attribute_value (entry, "name")), 0);
+  }
+
+  for (xml_node<>* block = registry->first_node ("enums"); block != NULL; block = block->next_sibling ("enums")) {
+    const std::string_view block_group = xml_attribute_value (block, "group");
+    const uint32_t         flags       = xml_attribute_value (block, "type") == "bitmask" ? GLV_GROUP_BITMASK : 0;
+
+    for (xml_node<>* entry = block->first_node ("enum"); entry != NULL; entry = entry->next_sibling ("enum")) {
+      const glv_id name = intern_name (db, xml_attribute_value (entry, "name"));
+
+      if (! block_group.empty ())
+        add_member (block_group, name, flags);
+
+      // Comma separated, e.g. group="TextureTarget,CopyImageSubDataTarget"
+      std::string_view entry_groups = xml_attribute_value (entry, "group");
+      while (! entry_groups.empty ()) {
+        const size_t comma = entry_groups.find (',');
+        add_member (entry_groups.substr (0, comma), name, flags);
+        entry_groups = comma != std::string_view::npos ? entry_groups.substr (comma + 1) : std::string_view ();
+      }
+    }
+  }
+
+  for (size_t i = 0; i < db.groups.size (); i++) {
+    db.groups [i].first_member = (uint32_t)db.group_members.size ();
+    db.groups [i].num_members  = (uint32_t)members [i].size ();
+    db.group_members.insert (db.group_members.end (), members [i].begin (), members [i].end ());
+  }
+
+  name_groups.resize (db.names.size ());
+
+  for (size_t name = 0; name < name_groups.size (); name++) {
+    db.names [name].first_group = (uint32_t)db.name_groups.size ();
+    db.names [name].num_groups  = (uint32_t)name_groups [name].size ();
+    db.name_groups.insert (db.name_groups.end (), name_groups [name].begin (), name_groups [name].end ());
+  }
+}
+
+// For every bitmask group, the member naming each of the 64 single bits (the first in registry order when
+//   several do), so decoding a mask is one lookup per set bit
+void build_group_bits (glv_db_builder& db)
+{
+  for (size_t i = 0; i < db.groups.size (); i++) {
+    glv_group_rec& group = db.groups [i];
+    if (! (group.flags & GLV_GROUP_BITMASK))
+      continue;
+
+    group.first_bit = (uint32_t)db.group_bits.size ();
+    db.group_bits.insert (db.group_bits.end (), 64, GLV_NONE);
+
+    for (uint32_t j = 0; j < group.num_members; j++) {
+      const glv_id name    = db.group_members [group.first_member + j];
+      const glv_id enum_id = db.names [name].enum_id;
+      if (enum_id == GLV_NONE)
+        continue;
+
+      // Only single bits; combinations like GL_ALL_ATTRIB_BITS are matched whole when decoding
+      const uint64_t value = db.enums [enum_id].value;
+      if (value == 0 || (value & (value - 1)) != 0)
+        continue;
+
+      uint32_t bit = 0;
+      while ((value >> bit) != 1)
+        ++bit;
+
+      if (db.group_bits [group.first_bit + bit] == GLV_NONE)
+        db.group_bits [group.first_bit + bit] = name;
+    }
+  }
+}
+
+void build_actions (glv_db_builder& db, xml_node<>* registry)
+{
+  std::vector <std::vector <glv_action_rec> > actions (db.names.size ());
+
+  xml_node<>* feature = registry->first_node ("feature");
+  for (glv_id feature_id = 0; feature != NULL; ++feature_id) {
+    xml_node<>* action = feature->first_node ();
+    while (action != NULL) {
+      const glv_verb verb = parse_verb (xml_name (action));
+      if (verb != GLV_NUM_VERBS) {
+        glv_action_rec record;
+        record.feature = feature_id;
+        record.verb    = verb;
+        record.profile = intern_string (db, xml_attribute_value (action, "profile"));
+
+        xml_node<>* entry = action->first_node ();
+        while (entry != NULL) {
+          const glv_id name = intern_name (db, xml_attribute_value (entry, "name"));
+          if (name >= actions.size ())
+            actions.resize (name + 1);
+
+          // A feature may list the same name in more than one block with the same profile
+          bool duplicate = false;
+          for (size_t i = 0; i < actions [name].size () && (! duplicate); i++) {
+            duplicate = actions [name][i].feature        == record.feature &&
+                        actions [name][i].verb           == record.verb    &&
+                        actions [name][i].profile.offset == record.profile.offset;
+          }
+
+          if (! duplicate)
+            actions [name].push_back (record);
+
+          entry = entry->next_sibling ();
+        }
+      }
+      action = action->next_sibling ();
+    }
+    feature = feature->next_sibling ("feature");
+  }
+
+  actions.resize (db.names.size ());
+
+  for (size_t name = 0; name < actions.size (); name++) {
+    // Records were appended in feature order, a stable sort by verb keeps that order within each verb
+    std::stable_sort (actions [name].begin (), actions [name].end (),
+                      [](const glv_action_rec& a, const glv_action_rec& b) { return a.verb < b.verb; });
+
+    db.names [name].first_action = (uint32_t)db.actions.size ();
+    db.names [name].num_actions  = (uint32_t)actions [name].size ();
+    db.actions.insert (db.actions.end (), actions [name].begin (), actions [name].end ());
+  }
+}
+
+void build_providers (glv_db_builder& db, xml_node<>* registry)
+{
+  std::vector <std::vector <glv_provider_rec> > providers (db.names.size ());
+
+  xml_node<>* extension = registry->first_node ("extensions")->first_node ("extension");
+  while (extension != NULL) {
+    glv_extension_rec extension_record;
+    extension_record.name      = intern_name (db, xml_attribute_value (extension, "name"));
+    extension_record.supported = parse_api_mask (xml_attribute_value (extension, "supported"));
+
+    const glv_id extension_id = (glv_id)db.extensions.size ();
+    db.names [extension_record.name].extension = extension_id;
+    db.extensions.push_back (extension_record);
+
+    xml_node<>* require = extension->first_node ("require");
+    while (require != NULL) {
+      // <require api="..."> narrows what this block provides (e.g. KHR_debug suffixes on ES only)
+      xml_attribute<>* api = require->first_attribute ("api");
+
+      glv_provider_rec record;
+      record.extension = extension_id;
+      record.apis      = api != NULL ? (extension_record.supported & parse_api_mask (xml_value (api))) : extension_record.supported;
+
+      xml_node<>* entry = require->first_node ();
+      while (entry != NULL) {
+        const glv_id name = intern_name (db, xml_attribute_value (entry, "name"));
+        if (name >= providers.size ())
+          providers.resize (name + 1);
+
+        // Several <require> blocks of one extension collapse into a single provider
+        if ((! providers [name].empty ()) && providers [name].back ().extension == extension_id)
+          providers [name].back ().apis |= record.apis;
+        else
+          providers [name].push_back (record);
+
+        entry = entry->next_sibling ();
+      }
+      require = require->next_sibling ("require");
+    }
+    extension = extension->next_sibling ("extension");
+  }
+
+  providers.resize (db.names.size ());
+
+  for (size_t name = 0; name < providers.size (); name++) {
+    db.names [name].first_provider = (uint32_t)db.providers.size ();
+    db.names [name].num_providers  = (uint32_t)providers [name].size ();
+    db.providers.insert (db.providers.end (), providers [name].begin (), providers [name].end ());
+  }
+}
+
+// Folds the (feature, verb, profile) actions of every name into one bitset per feature, verb and profile;
+//   runs after every name has been interned, since the bitsets are sized by the final name count
+void build_feature_sets (glv_db_builder& db)
+{
+  const uint32_t num_words = ((uint32_t)db.names.size () + 63) / 64;
+
+  // Ordered by feature, then require before remove
+  std::map <std::tuple <glv_id, uint32_t, uint32_t, uint32_t>, std::vector <uint64_t> > sets;
+
+  for (size_t name = 0; name < db.names.size (); name++) {
+    for (uint32_t i = 0; i < db.names [name].num_actions; i++) {
+      const glv_action_rec& action = db.actions [db.names [name].first_action + i];
+      if (action.verb == GLV_DEPRECATE)
+        continue;
+
+      std::vector <uint64_t>& bits = sets [std::make_tuple (action.feature, action.verb, action.profile.offset, action.profile.length)];
+      if (bits.empty ())
+        bits.resize (num_words);
+      bits [name / 64] |= (uint64_t)1 << (name % 64);
+    }
+  }
+
+  for (const auto& set : sets) {
+    glv_feature_rec& feature = db.features [std::get <0> (set.first)];
+    if (feature.num_sets++ == 0)
+      feature.first_set = (uint32_t)db.feature_sets.size ();
+
+    glv_feature_set_rec record;
+    record.verb           = std::get <1> (set.first);
+    record.profile.offset = std::get <2> (set.first);
+    record.profile.length = std::get <3> (set.first);
+    record.first_word     = (uint32_t)db.feature_words.size ();
+
+    db.feature_sets.push_back (record);
+    db.feature_words.insert (db.feature_words.end (), set.second.begin (), set.second.end ());
+  }
+}
+
+size_t find_alias_root (std::vector <size_t>& parent, size_t i)
+{
+  while (parent [i] != i) {
+    parent [i] = parent [parent [i]];
+    i          = parent [i];
+  }
+
+  return i;
+}
+
+// Groups every command with everything it aliases or is aliased by, transitively
+void build_alias_classes (glv_db_builder& db)
+{
+  std::vector <size_t> parent (db.commands.size ());
+  for (size_t i = 0; i < parent.size (); i++)
+    parent [i] = i;
+
+  for (size_t i = 0; i < db.commands.size (); i++) {
+    if (db.commands [i].alias == GLV_NONE)
+      continue;
+
+    const glv_id target = db.names [db.commands [i].alias].command;
+    if (target == GLV_NONE)
+      continue;
+
+    const size_t a = find_alias_root (parent, i);
+    const size_t b = find_alias_root (parent, target);
+    parent [std::max (a, b)] = std::min (a, b);
+  }
+
+  std::vector <size_t> class_size (db.commands.size (), 0);
+  for (size_t i = 0; i < db.commands.size (); i++)
+    ++class_size [find_alias_root (parent, i)];
+
+  std::vector <std::vector <glv_id> > members;
+  std::unordered_map <size_t, glv_id> root_class;
+
+  for (size_t i = 0; i < db.commands.size (); i++) {
+    const size_t root = find_alias_root (parent, i);
+
+    // Unaliased commands do not get a class
+    if (class_size [root] < 2)
+      continue;
+
+    std::unordered_map <size_t, glv_id>::iterator id = root_class.find (root);
+    if (id == root_class.end ()) {
+      id = root_class.emplace (root, (glv_id)members.size ()).first;
+      members.push_back (std::vector <glv_id> ());
+    }
+
+    members [id->second].push_back ((glv_id)i);
+    db.commands [i].alias_class = id->second;
+  }
+
+  for (size_t i = 0; i < members.size (); i++) {
+    glv_alias_rec record;
+    record.canonical    = GLV_NONE;
+    record.first_member = (uint32_t)db.alias_members.size ();
+    record.num_members  = (uint32_t)members [i].size ();
+
+    for (size_t j = 0; j < members [i].size () && record.canonical == GLV_NONE; j++) {
+      if (db.commands [members [i][j]].alias == GLV_NONE)
+        record.canonical = members [i][j];
+    }
+
+    // A cycle or a dangling alias target leaves no obvious canonical name; fall back to the first member
+    if (record.canonical == GLV_NONE)
+      record.canonical = members [i].front ();
+
+    db.alias_members.insert (db.alias_members.end (), members [i].begin (), members [i].end ());
+    db.alias_classes.push_back (record);
+  }
+}
+
+// Seeds tried per bucket before giving up; gl.xml needs a few dozen at most
+const uint32_t glv_max_hash_seed = 1 << 20;
+
+// Hash and displace: names are split into buckets by one half of their hash, and each bucket (largest first)
+//   gets the first seed that drops all of its names into free slots. A lookup is then one seed read and one probe.
+//   Two names with the same 64-bit hash can never be separated, so that fails instead of searching forever.
+bool build_name_hash (glv_db_builder& db)
+{
+  const uint32_t num_names   = (uint32_t)db.names.size ();
+  const uint32_t num_buckets = num_names / 4 + 1;
+  const uint32_t num_slots   = num_names + num_names / 4 + 1;
+
+  std::vector <uint64_t>              hashes  (num_names);
+  std::vector <std::vector <glv_id> > buckets (num_buckets);
+
+  for (glv_id i = 0; i < num_names; i++) {
+    hashes [i] = hash_name (std::string_view (&db.strings [db.names [i].text.offset], db.names [i].text.length));
+    buckets [hash_bucket (hashes [i], num_buckets)].push_back (i);
+  }
+
+  std::vector <uint32_t> order (num_buckets);
+  for (uint32_t i = 0; i < num_buckets; i++)
+    order [i] = i;
+
+  std::stable_sort (order.begin (), order.end (),
+                    [&buckets](uint32_t a, uint32_t b) { return buckets [a].size () > buckets [b].size (); });
+
+  db.hash_seeds.assign (num_buckets, 0);
+  db.hash_slots.assign (num_slots,   GLV_NONE);
+
+  std::vector <uint32_t> slots;
+
+  for (uint32_t i = 0; i < num_buckets && (! buckets [order [i]].empty ()); i++) {
+    const std::vector <glv_id>& bucket = buckets [order [i]];
+
+    uint32_t seed = 1;
+    for (; seed <= glv_max_hash_seed; seed++) {
+      slots.clear ();
+
+      bool placed = true;
+      for (size_t j = 0; j < bucket.size () && placed; j++) {
+        const uint32_t slot = hash_slot (hashes [bucket [j]], seed, num_slots);
+        placed = db.hash_slots [slot] == GLV_NONE && std::find (slots.begin (), slots.end (), slot) == slots.end ();
+        slots.push_back (slot);
+      }
+
+      if (placed) {
+        for (size_t j = 0; j < bucket.size (); j++)
+          db.hash_slots [slots [j]] = bucket [j];
+        db.hash_seeds [order [i]] = seed;
+        break;
+      }
+    }
+
+    if (seed > glv_max_hash_seed) {
+      auto text = [&db](glv_id id) { return std::string_view (&db.strings [db.names [id].text.offset], db.names [id].text.length); };
+
+      for (size_t j = 0; j < bucket.size (); j++) {
+        for (size_t k = j + 1; k < bucket.size (); k++) {
+          if (hashes [bucket [j]] == hashes [bucket [k]]) {
+            printf (" @ ERROR: '%.*s' and '%.*s' have the same name hash\n",
+                    GLV_FMT_STR (text (bucket [j])), GLV_FMT_STR (text (bucket [k])));
+            return false;
+          }
+        }
+      }
+
+      printf (" @ ERROR: No seed in 1..%u places a bucket of %zu names\n", glv_max_hash_seed, bucket.size ());
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Every name id in byte order of its text, for prefix queries
+void build_sorted_names (glv_db_builder& db)
+{
+  db.names_sorted.resize (db.names.size ());
+  for (size_t i = 0; i < db.names_sorted.size (); i++)
+    db.names_sorted [i] = (glv_id)i;
+
+  auto text = [&db](glv_id id) { return std::string_view (&db.strings [db.names [id].text.offset], db.names [id].text.length); };
+
+  std::sort (db.names_sorted.begin (), db.names_sorted.end (), [&text](glv_id a, glv_id b) { return text (a) < text (b); });
+}
+
+// False when the names cannot be perfectly hashed
+bool build_db (glv_db_builder& db, xml_node<>* registry)
+{
+  build_features      (db, registry);
+  build_commands      (db, registry);
+  build_enums         (db, registry);
+  build_types         (db, registry);
+  build_groups        (db, registry);
+  build_group_bits    (db);
+  build_actions       (db, registry);
+  build_providers     (db, registry);
+  build_feature_sets  (db);
+  build_alias_classes (db);
+  if (! build_name_hash (db))
+    return false;
+  build_sorted_names  (db);
+
+  db.name_ids.clear   ();
+  db.string_ids.clear ();
+
+  return true;
+}
+
+
+//
+// Files
+//
+
+// A read-only, NUL terminated file image; parse_non_destructive never writes to it, so a mapping of the
+//   registry (or of a snapshot) can be shared with every other process that maps it
+struct glv_file {
+  const char* data;
+  size_t      size;     // Bytes of file data, excluding the terminator
+  size_t      reserved; // Bytes reserved for the image, including the terminator
+  bool        mapped;
+};
+
+double elapsed_ms (std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration <double, std::milli> (std::chrono::steady_clock::now () - start).count ();
+}
+
+// Maps the file read-only and shared; falls back to reading it into one private buffer where mapping is unavailable.
+bool load_file (const char* path, glv_file& file)
+{
+  file.data     = NULL;
+  file.size     = 0;
+  file.reserved = 0;
+  file.mapped   = false;
+
+#if ! defined (_WIN32)
+  int fd = open (path, O_RDONLY);
+  if (fd == -1)
+    return false;
+
+  struct stat info;
+  if (fstat (fd, &info) == -1) {
+    close (fd);
+    return false;
+  }
+
+  file.size     = (size_t)info.st_size;
+  file.reserved = file.size + 1;
+
+  // Reserve one byte past the end as anonymous zeroed memory, then map the file over the front of it;
+  //   that byte is the terminator even when the file size is an exact multiple of the page size.
+  void* image = mmap (NULL, file.reserved, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (image != MAP_FAILED && file.size > 0) {
+    if (mmap (image, file.size, PROT_READ, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+      munmap (image, file.reserved);
+      image = MAP_FAILED;
+    }
+  }
+  close (fd);
+
+  if (image == MAP_FAILED)
+    return false;
+
+  // rapidxml makes a single front-to-back pass
+  madvise (image, file.reserved, MADV_SEQUENTIAL);
+  madvise (image, file.reserved, MADV_WILLNEED);
+
+  file.data   = (const char *)image;
+  file.mapped = true;
+#else
+  FILE* in = fopen (path, "rb");
+  if (in == NULL)
+    return false;
+
+  fseek (in, 0, SEEK_END);
+  file.size     = (size_t)ftell (in);
+  file.reserved = file.size + 1;
+  fseek (in, 0, SEEK_SET);
+
+  char* data = (char *)malloc (file.reserved);
+  if (data == NULL || fread (data, 1, file.size, in) != file.size) {
+    free   (data);
+    fclose (in);
+    return false;
+  }
+  fclose (in);
+
+  data [file.size] = '\0';
+  file.data        = data;
+#endif
+
+  return true;
+}
+
+void unload_file (glv_file& file)
+{
+  if (file.data == NULL)
+    return;
+
+#if ! defined (_WIN32)
+  if (file.mapped)
+    munmap ((void *)file.data, file.reserved);
+#else
+  free ((void *)file.data);
+#endif
+
+  file.data = NULL;
+}
+
+// What stat says about a file, precise enough to tell it has not changed: an edit moves the change time
+//   even when it keeps the size and the modification time (cp -p, rsync -t and touch -r all set mtime
+//   back), and a copy or replacement is a different inode
+struct glv_file_id {
+  uint64_t size;
+  int64_t  mtime;  // Nanoseconds
+  int64_t  ctime;  // Nanoseconds
+  uint64_t inode;
+};
+
+#if defined (__APPLE__)
+# define GLV_STAT_NS(info, time) ((int64_t)(info).st_##time##espec.tv_sec * 1000000000 + (info).st_##time##espec.tv_nsec)
+#elif ! defined (_WIN32)
+# define GLV_STAT_NS(info, time) ((int64_t)(info).st_##time.tv_sec * 1000000000 + (info).st_##time.tv_nsec)
+#else
+# define GLV_STAT_NS(info, time) ((int64_t)(info).st_##time * 1000000000)
+#endif
+
+bool identify_file (const char* path, glv_file_id& id)
+{
+  struct stat info;
+
+  memset (&id, 0, sizeof (id));
+  if (stat (path, &info) != 0)
+    return false;
+
+  id.size  = (uint64_t)info.st_size;
+  id.mtime = GLV_STAT_NS (info, mtim);
+  id.ctime = GLV_STAT_NS (info, ctim);
+  id.inode = (uint64_t)info.st_ino;
+
+  return true;
+}
+
+bool same_file_id (const glv_file_id& a, const glv_file_id& b)
+{
+#if defined (_WIN32)
+  // No inode, and st_ctime is the creation time; nothing short of the content tells an edit apart
+  (void)a;
+  (void)b;
+  return false;
+#else
+  return a.size == b.size && a.mtime == b.mtime && a.ctime == b.ctime && a.inode == b.inode;
+#endif
+}
+
+// 64-bit content hash for snapshot staleness checks; a word at a time so re-hashing gl.xml stays cheap
+uint64_t hash_bytes (const char* data, size_t size)
+{
+  uint64_t hash = 0x9E3779B97F4A7C15ull ^ size;
+  size_t   i    = 0;
+
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    memcpy (&word, data + i, sizeof (word));
+    hash  = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 32;
+  }
+
+  for (; i < size; i++)
+    hash = (hash ^ (uint8_t)data [i]) * 0x100000001B3ull;
+
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53ull;
+  hash ^= hash >> 33;
+
+  return hash;
+}
+
+// ("gl.xml", ".sock") -> "gl.sock"
+std::string replace_extension (const char* file_path, const char* extension)
+{
+  std::string path (file_path);
+
+  const size_t dot   = path.rfind ('.');
+  const size_t slash = path.find_last_of ("/\\");
+
+  if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+    path.erase (dot);
+
+  return path + extension;
+}
+
+// "gl.xml" -> "gl.glvsdb"
+std::string snapshot_path (const char* registry_path)
+{
+  return replace_extension (registry_path, ".glvsdb");
+}
+
+
+//
+// Snapshots (.glvsdb)
+//
+//   A header, a directory with one entry per GLV_DB_TABLES table, then each table's records verbatim at
+//     8-byte aligned offsets. Loading is a mapping plus bounds checks; nothing is parsed or copied.
+//
+const char     glv_snapshot_magic [8]  = { 'G', 'L', 'V', 'S', 'D', 'B', '\r', '\n' };
+const uint32_t glv_snapshot_version    = 9;
+const uint32_t glv_snapshot_byte_order = 0x01020304;
+
+struct glv_snapshot_header {
+  char     magic [8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t    source_hash; // hash_bytes of the gl.xml it was compiled from
+  glv_file_id source;      // When identify_file still says the same, the hash need not be checked
+  uint32_t    num_tables;
+  uint32_t reserved;
+};
+
+struct glv_snapshot_table {
+  uint64_t offset;
+  uint32_t count;
+  uint32_t record_size;
+};
+
+enum glv_snapshot_status {
+  GLV_SNAPSHOT_OK,
+  GLV_SNAPSHOT_MISSING,
+  GLV_SNAPSHOT_STALE,   // Compiled from a different gl.xml, or by a different build of glvs
+  GLV_SNAPSHOT_INVALID
+};
+
+bool write_snapshot (const char* path, const glv_db& db, const glv_file& source, const char* source_path)
+{
+  glv_snapshot_header header;
+  memset (&header, 0, sizeof (header));
+  memcpy (header.magic, glv_snapshot_magic, sizeof (header.magic));
+  header.version     = glv_snapshot_version;
+  header.byte_order  = glv_snapshot_byte_order;
+  header.source_hash = hash_bytes (source.data, source.size);
+  header.num_tables  = glv_db_num_tables;
+
+  // A source that changes between being read and being stamped is simply re-hashed on the next load
+  if (! identify_file (source_path, header.source))
+    header.source.size = source.size;
+
+  std::vector <glv_snapshot_table> tables;
+  uint64_t offset = sizeof (header) + glv_db_num_tables * sizeof (glv_snapshot_table);
+
+#define GLV_DB_PLACE_TABLE(type, table)                                   \
+  {                                                                       \
+    offset = (offset + 7) & ~(uint64_t)7;                                 \
+    glv_snapshot_table entry = { offset, db.table.count, sizeof (type) }; \
+    tables.push_back (entry);                                             \
+    offset += (uint64_t)db.table.count * sizeof (type);                   \
+  }
+  GLV_DB_TABLES (GLV_DB_PLACE_TABLE)
+#undef GLV_DB_PLACE_TABLE
+
+  // Write beside the destination and rename over it, so a concurrent reader never maps half a snapshot
+  const std::string temp_path = std::string (path) + ".tmp";
+
+  FILE* out = fopen (temp_path.c_str (), "wb");
+  if (out == NULL)
+    return false;
+
+  uint64_t position = sizeof (header) + tables.size () * sizeof (glv_snapshot_table);
+  bool     written  = fwrite (&header,       sizeof (header),             1,               out) == 1 &&
+                      fwrite (tables.data (), sizeof (glv_snapshot_table), tables.size (), out) == tables.size ();
+
+  size_t     table_idx   = 0;
+  const char padding [8] = { };
+
+#define GLV_DB_WRITE_TABLE(type, table)                                                                  \
+  if (written) {                                                                                         \
+    const glv_snapshot_table& entry = tables [table_idx++];                                              \
+    written  = fwrite (padding, 1, (size_t)(entry.offset - position), out) == entry.offset - position;   \
+    written  = written && fwrite (db.table.data, sizeof (type), db.table.count, out) == db.table.count;  \
+    position = entry.offset + (uint64_t)db.table.count * sizeof (type);                                  \
+  }
+  GLV_DB_TABLES (GLV_DB_WRITE_TABLE)
+#undef GLV_DB_WRITE_TABLE
+
+  written = (fclose (out) == 0) && written;
+
+  if (written) {
+#if defined (_WIN32)
+    remove (path);
+#endif
+    written = rename (temp_path.c_str (), path) == 0;
+  }
+
+  if (! written)
+    remove (temp_path.c_str ());
+
+  return written;
+}
+
+// Records gl.xml's new timestamp in the snapshot once its content is known to be unchanged, so the next
+//   load is back to comparing size and timestamp. Best effort; a read-only snapshot is simply re-hashed again.
+void restamp_snapshot (const char* path, const glv_file_id& source)
+{
+  FILE* out = fopen (path, "r+b");
+  if (out == NULL)
+    return;
+
+  if (fseek (out, (long)offsetof (glv_snapshot_header, source), SEEK_SET) == 0)
+    fwrite (&source, sizeof (source), 1, out);
+
+  fclose (out);
+}
+
+// An unchanged identify_file is enough; anything else about gl.xml moving gets it re-hashed
+bool snapshot_matches_source (const glv_snapshot_header& header, const char* path, const char* source_path)
+{
+  glv_file_id current;
+
+  // Without a registry to compare against, the snapshot is all there is
+  if (! identify_file (source_path, current))
+    return true;
+
+  if (current.size != header.source.size)
+    return false;
+
+  if (same_file_id (current, header.source))
+    return true;
+
+  glv_file source;
+  if (! load_file (source_path, source))
+    return false;
+
+  const bool matches = hash_bytes (source.data, source.size) == header.source_hash;
+  unload_file (source);
+
+  // Only touched or copied (a checkout, an extracted archive); keep the snapshot from re-hashing on every load
+  if (matches)
+    restamp_snapshot (path, current);
+
+  return matches;
+}
+
+// Every id and (first, count) range in the tables lands inside the table it indexes, so a corrupt or
+//   truncated snapshot is rejected up front instead of read out of bounds. One pass over each table.
+bool snapshot_ids_valid (const glv_db& db)
+{
+  auto in_table = [] (uint64_t first, uint64_t count, uint32_t table_count) { return first + count <= table_count; };
+  auto is_id    = [] (glv_id id, uint32_t table_count) { return id < table_count; };
+  auto is_ref   = [] (glv_id id, uint32_t table_count) { return id == GLV_NONE || id < table_count; };
+  auto is_str   = [&db, &in_table] (glv_str text) { return in_table (text.offset, text.length, db.strings.count); };
+
+  for (uint32_t i = 0; i < db.names.count; i++) {
+    const glv_name_rec& record = db.names [i];
+    if (! (is_str   (record.text) && is_ref (record.command, db.commands.count) && is_ref (record.enum_id, db.enums.count) &&
+           is_ref   (record.feature, db.features.count) && is_ref (record.extension, db.extensions.count) &&
+           is_ref   (record.group, db.groups.count) &&
+           in_table (record.first_action,   record.num_actions,   db.actions.count)   &&
+           in_table (record.first_provider, record.num_providers, db.providers.count) &&
+           in_table (record.first_group,    record.num_groups,    db.name_groups.count)))
+      return false;
+  }
+
+  for (uint32_t i = 0; i < db.commands.count; i++) {
+    const glv_command_rec& record = db.commands [i];
+    if (! (is_id  (record.name, db.names.count) && is_ref (record.alias, db.names.count) &&
+           is_ref (record.alias_class, db.alias_classes.count) &&
+           in_table (record.first_param, record.num_params, db.params.count) && is_str (record.proto) && is_str (record.ptype)))
+      return false;
+  }
+
+  for (uint32_t i = 0; i < db.params.count; i++) {
+    const glv_param_rec& record = db.params [i];
+    if (! (is_str (record.type) && is_str (record.ptype) && is_str (record.name)))
+      return false;
+  }
+
+  for (uint32_t i = 0; i < db.types.count; i++) {
+    const glv_type_rec& record = db.types [i];
+    if (! (is_id (record.name, db.names.count) && is_str (record.api) && is_str (record.text) && is_ref (record.required_type, db.names.count)))
+      return false;
+  }
+
+  for (uint32_t i = 0; i < db.enums.count; i++) {
+    if (! (is_id (db.enums [i].name, db.names.count) && is_ref (db.enums [i].alias, db.names.count) && is_str (db.enums [i].api)))
+      return false;
+  }
+
+  for (uint32_t i = 0; i < db.features.count; i++) {
+    const glv_feature_rec& record = db.features [i];
+    if (! (is_id (record.name, db.names.count) && is_str (record.api) && is_str (record.number) &&
+           in_table (record.first_set, record.num_sets, db.feature_sets.count)))
+      return false;
+  }
+
+  for (uint32_t i = 0; i < db.feature_sets.count; i++) {
+    const glv_feature_set_rec& record = db.feature_sets [i];
+    if (! (record.verb < GLV_NUM_VERBS && is_str (record.profile) && in_table (record.first_word, set_words (db), db.feature_words.count)))
+      return false;
+  }
+
+  for (uint32_t i = 0; i < db.extensions.count; i++) {
+    if (! is_id (db.extensions [i].name, db.names.count))
+      return false;
+  }
+
+  for (uint32_t i = 0; i < db.actions.count; i++) {
+    const glv_action_rec& record = db.actions [i];
+    if (! (is_id (record.feature, db.features.count) && record.verb < GLV_NUM_VERBS && is_str (record.profile)))
+      return false;
+  }
+
+  for (uint32_t i = 0; i < db.providers.count; i++) {
+    if (! is_id (db.providers [i].extension, db.extensions.count))
+      return false;
+  }
+
+  for (uint32_t i = 0; i < db.alias_classes.count; i++) {
+    const glv_alias_rec& record = db.alias_classes [i];
+    if (! (is_id (record.canonical, db.commands.count) && in_table (record.first_member, record.num_members, db.alias_members.count)))
+      return false;
+  }
+
+  for (uint32_t i = 0; i < db.groups.count; i++) {
+    const glv_group_rec& record = db.groups [i];
+    if (! (is_str (record.name) && in_table (record.first_member, record.num_members, db.group_members.count) &&
+           (record.first_bit == GLV_NONE || in_table (record.first_bit, 64, db.group_bits.count))))
+      return false;
+  }
+
+  // The flat id lists, each checked against the table its entries index
+  const struct { glv_table <glv_id> ids; uint32_t count; bool none_allowed; } lists [] = {
+    { db.alias_members,  db.commands.count,    false },
+    { db.group_members,  db.names.count,       false },
+    { db.name_groups,    db.groups.count,      false },
+    { db.group_bits,     db.names.count,       true  },
+    { db.enums_by_value, db.enums.count,       false },
+    { db.names_sorted,   db.names.count,       false },
+    { db.hash_slots,     db.names.count,       true  }
+  };
+
+  for (size_t l = 0; l < sizeof (lists) / sizeof (lists [0]); l++) {
+    for (uint32_t i = 0; i < lists [l].ids.count; i++) {
+      const glv_id id = lists [l].ids [i];
+      if (! (id < lists [l].count || (lists [l].none_allowed && id == GLV_NONE)))
+        return false;
+    }
+  }
+
+  // find_name divides by the number of seeds
+  return db.hash_slots.count == 0 || db.hash_seeds.count != 0;
+}
+
+glv_snapshot_status load_snapshot (const char* path, const char* source_path, glv_file& file, glv_db& db)
+{
+  if (! load_file (path, file))
+    return GLV_SNAPSHOT_MISSING;
+
+  glv_snapshot_header header;
+  if (file.size < sizeof (header) + glv_db_num_tables * sizeof (glv_snapshot_table)) {
+    unload_file (file);
+    return GLV_SNAPSHOT_INVALID;
+  }
+
+  memcpy (&header, file.data, sizeof (header));
+
+  if (memcmp (header.magic, glv_snapshot_magic, sizeof (header.magic))) {
+    unload_file (file);
+    return GLV_SNAPSHOT_INVALID;
+  }
+
+  if (header.version    != glv_snapshot_version    ||
+      header.byte_order != glv_snapshot_byte_order ||
+      header.num_tables != glv_db_num_tables       ||
+      (! snapshot_matches_source (header, path, source_path))) {
+    unload_file (file);
+    return GLV_SNAPSHOT_STALE;
+  }
+
+  const glv_snapshot_table* tables    = (const glv_snapshot_table *)(file.data + sizeof (header));
+  size_t                    table_idx = 0;
+  bool                      valid     = true;
+
+#define GLV_DB_MAP_TABLE(type, table)                                                 \
+  {                                                                                   \
+    const glv_snapshot_table& entry = tables [table_idx++];                           \
+    valid = valid && entry.record_size == sizeof (type) && (entry.offset & 7) == 0 && \
+            entry.offset + (uint64_t)entry.count * sizeof (type) <= file.size;       \
+    db.table.data  = valid ? (const type *)(file.data + entry.offset) : NULL;         \
+    db.table.count = valid ? entry.count : 0;                                         \
+  }
+  GLV_DB_TABLES (GLV_DB_MAP_TABLE)
+#undef GLV_DB_MAP_TABLE
+
+  // A record layout that changed without a version bump; treat it like any other stale snapshot
+  if (! valid) {
+    unload_file (file);
+    return GLV_SNAPSHOT_STALE;
+  }
+
+  if (! snapshot_ids_valid (db)) {
+    unload_file (file);
+    return GLV_SNAPSHOT_INVALID;
+  }
+
+  return GLV_SNAPSHOT_OK;
+}
+
+
+//
+// Output
+//
+void print_lifecycle (FILE* out, const glv_db& db, glv_id name)
+{
+  const glv_table <glv_action_rec> actions = find_actions (db, name);
+
+  for (uint32_t i = 0; i < actions.count; i++) {
+    const glv_action_rec&  action  = actions [i];
+    const glv_feature_rec& feature = db.features [action.feature];
+
+    fprintf (out, "  * %-15s %24.*s    (%5.*s %2.1f)", glv_verb_desc [action.verb],
+                                                      GLV_FMT_STR (db.name (feature.name)),
+                                                      GLV_FMT_STR (db.str  (feature.api)),
+                                     parse_version (db.str (feature.number)));
+    if (action.profile.length != 0)
+      fprintf (out, " [%.*s]", GLV_FMT_STR (db.str (action.profile)));
+    fprintf (out, "\n");
+  }
+}
+
+void print_providers (FILE* out, const glv_db& db, glv_id name)
+{
+  const glv_table <glv_provider_rec> providers = find_ext_reqs (db, name);
+
+  if (providers.count == 0)
+    return;
+
+  for (uint32_t i = 0; i < providers.count; i++) {
+    fprintf (out, "  * Provided by %.*s (%s)\n", GLV_FMT_STR (db.name (db.extensions [providers [i].extension].name)),
+                                                 format_api_mask (providers [i].apis).c_str ());
+  }
+
+  fprintf (out, "\n");
+}
+
+// "void glBindBuffer (GLenum target, GLuint buffer)"
+std::string format_signature (const glv_db& db, glv_id command_id)
+{
+  const glv_command_rec& command = db.commands [command_id];
+
+  std::string signature (db.str (command.proto));
+  signature += db.name (command.name);
+  signature += " (";
+
+  for (uint32_t i = 0; i < command.num_params; i++) {
+    const glv_param_rec& param = db.params [command.first_param + i];
+    if (i != 0)
+      signature += ", ";
+    signature += db.str (param.type);
+    signature += db.str (param.name);
+  }
+
+  if (command.num_params == 0)
+    signature += "void";
+
+  return signature + ")";
+}
+
+void print_command (FILE* out, const glv_db& db, glv_id command_id)
+{
+  const glv_command_rec& command = db.commands [command_id];
+
+  fprintf (out, "--------------------------------\n");
+  fprintf (out, " >> Command:  %s\n\n", format_signature (db, command_id).c_str ());
+
+  print_providers (out, db, command.name);
+
+  print_lifecycle (out, db, command.name);
+
+  // The signature and print_providers already end with a blank line; only the lifecycle lines do not
+  const glv_alias_rec* command_aliases = find_command_aliases (db, command_id);
+  if (command_aliases != NULL) {
+    if (find_actions (db, command.name).count != 0)
+      fprintf (out, "\n");
+
+    // Canonical name first, then the remaining aliases in registry order
+    std::vector <glv_id> members (1, command_aliases->canonical);
+    for (uint32_t i = 0; i < command_aliases->num_members; i++) {
+      const glv_id member = db.alias_members [command_aliases->first_member + i];
+      if (member != command_aliases->canonical)
+        members.push_back (member);
+    }
+
+    for (size_t i = 0; i < members.size (); i++) {
+      if (members [i] == command_id)
+        continue;
+
+      const glv_id alias_name = db.commands [members [i]].name;
+      if (members [i] == command_aliases->canonical)
+        fprintf (out, " >> Command Alias: %.*s (canonical) <<\n", GLV_FMT_STR (db.name (alias_name)));
+      else
+        fprintf (out, " >> Command Alias: %.*s <<\n", GLV_FMT_STR (db.name (alias_name)));
+
+      print_providers (out, db, alias_name);
+    }
+  }
+}
+
+void print_enum (FILE* out, const glv_db& db, glv_id enum_id)
+{
+  const glv_enum_rec& enum_entry = db.enums [enum_id];
+
+  fprintf (out, "--------------------------------\n");
+  fprintf (out, " >> Enum:   %.*s is 0x%04llX\n\n", GLV_FMT_STR (db.name (enum_entry.name)), (unsigned long long)enum_entry.value);
+
+  // For non-core tokens, find the extension
+  print_providers (out, db, enum_entry.name);
+
+  print_lifecycle (out, db, enum_entry.name);
+
+  // As in print_command, only the lifecycle lines need a blank line after them
+  if (find_actions (db, enum_entry.name).count != 0)
+    fprintf (out, "\n");
+
+  const glv_table <glv_id> enum_aliases = find_enums_by_value (db, enum_entry.value);
+  for (uint32_t i = 0; i < enum_aliases.count; i++) {
+    const glv_enum_rec& enum_alias = db.enums [enum_aliases [i]];
+    if (enum_aliases [i] == enum_id)
+      continue;
+
+    fprintf (out, " >> Enum Alias: %.*s <<\n", GLV_FMT_STR (db.name (enum_alias.name)));
+
+    print_providers (out, db, enum_alias.name);
+  }
+}
+
+void print_suggestions (FILE* out, const glv_db& db, std::string_view name)
+{
+  const std::vector <glv_suggestion> suggestions = find_similar_names (db, name);
+
+  if (suggestions.empty ())
+    return;
+
+  fprintf (out, "\n");
+
+  for (size_t i = 0; i < suggestions.size (); i++) {
+    if (suggestions [i].distance == 0)
+      fprintf (out, "  * Did you mean %.*s? (differs in case)\n", GLV_FMT_STR (db.name (suggestions [i].name)));
+    else
+      fprintf (out, "  * Did you mean %.*s? (%u edit%s)\n", GLV_FMT_STR (db.name (suggestions [i].name)),
+                                                            suggestions [i].distance, suggestions [i].distance != 1 ? "s" : "");
+  }
+}
+
+// " command", " enum extension", ...
+void print_name_kinds (FILE* out, const glv_db& db, glv_id name)
+{
+  const glv_name_rec& record = db.names [name];
+
+  if (record.command   != GLV_NONE) fprintf (out, " command");
+  if (record.enum_id   != GLV_NONE) fprintf (out, " enum");
+  if (record.extension != GLV_NONE) fprintf (out, " extension");
+  if (record.feature   != GLV_NONE) fprintf (out, " feature");
+}
+
+void print_prefix (FILE* out, const glv_db& db, std::string_view prefix, const std::vector <glv_id>& matches)
+{
+  fprintf (out, "--------------------------------\n");
+  fprintf (out, " >> Prefix: %.*s* matches %zu names\n\n", GLV_FMT_STR (prefix), matches.size ());
+
+  for (size_t i = 0; i < matches.size (); i++) {
+    fprintf (out, "  * %-56.*s", GLV_FMT_STR (db.name (matches [i])));
+    print_name_kinds (out, db, matches [i]);
+    fprintf (out, "\n");
+  }
+}
+
+// Every enum defined with value, with its groups, APIs, providers and lifecycle. A name defined once per API
+//   is listed once, with each API it is defined for.
+void print_value (FILE* out, const glv_db& db, unsigned long long value)
+{
+  const glv_table <glv_id> enums = find_enums_by_value (db, value);
+
+  std::vector <glv_id> names;
+  for (uint32_t i = 0; i < enums.count; i++) {
+    if (std::find (names.begin (), names.end (), db.enums [enums [i]].name) == names.end ())
+      names.push_back (db.enums [enums [i]].name);
+  }
+
+  fprintf (out, "--------------------------------\n");
+  // Negative values (GL_NEXT_BUFFER_NV is -2) read better signed
+  fprintf (out, (long long)value < 0 ? " >> Value:  0x%04llX (%lld) matches %zu enum%s\n\n" : " >> Value:  0x%04llX (%llu) matches %zu enum%s\n\n",
+                value, value, names.size (), names.size () != 1 ? "s" : "");
+
+  for (size_t i = 0; i < names.size (); i++) {
+    fprintf (out, " >> %.*s\n", GLV_FMT_STR (db.name (names [i])));
+
+    const glv_table <glv_id> groups = find_groups (db, names [i]);
+    if (groups.count != 0) {
+      fprintf (out, "  * Groups:   ");
+      for (uint32_t j = 0; j < groups.count; j++)
+        fprintf (out, "%s%.*s", j != 0 ? ", " : "", GLV_FMT_STR (db.str (db.groups [groups [j]].name)));
+      fprintf (out, "\n");
+    }
+
+    fprintf (out, "  * API:      ");
+    bool first = true;
+    for (uint32_t j = 0; j < enums.count; j++) {
+      const glv_enum_rec& record = db.enums [enums [j]];
+      if (record.name != names [i])
+        continue;
+      fprintf (out, "%s%.*s", first ? "" : ", ", GLV_FMT_STR (record.api.length != 0 ? db.str (record.api) : std::string_view ("all")));
+      first = false;
+    }
+    fprintf (out, "\n\n");
+
+    print_providers (out, db, names [i]);
+    print_lifecycle (out, db, names [i]);
+
+    // print_providers already ends with a blank line when there is nothing after it
+    if (i + 1 < names.size () && (find_actions (db, names [i]).count != 0 || find_ext_reqs (db, names [i]).count == 0))
+      fprintf (out, "\n");
+  }
+}
+
+// A mask broken down into the named bits of each group: members equal to the whole value first, then one
+//   line per set bit, with bits the group does not name marked '?'
+void print_bits (FILE* out, const glv_db& db, unsigned long long value, const std::vector <glv_id>& groups)
+{
+  fprintf (out, "--------------------------------\n");
+
+  for (size_t i = 0; i < groups.size (); i++) {
+    fprintf (out, "%s >> Bits:   0x%08llX in %.*s\n\n", i != 0 ? "\n" : "", value, GLV_FMT_STR (db.str (db.groups [groups [i]].name)));
+
+    // A single bit is listed below anyway
+    if (count_bits (value) != 1) {
+      const std::vector <glv_id> whole = find_group_members (db, groups [i], value);
+      for (size_t j = 0; j < whole.size (); j++)
+        fprintf (out, "  = 0x%08llX  %.*s\n", value, GLV_FMT_STR (db.name (whole [j])));
+
+      if (value == 0 && whole.empty ())
+        fprintf (out, "  (no bits set)\n");
+    }
+
+    uint64_t                   unknown;
+    const std::vector <glv_id> bits = decode_bits (db, groups [i], value, unknown);
+
+    // Lowest bit first, named or not
+    size_t named = 0;
+    for (uint32_t bit = 0; bit < 64; bit++) {
+      const uint64_t mask = 1ull << bit;
+      if (! (value & mask))
+        continue;
+
+      if (unknown & mask) {
+        fprintf (out, "  ? 0x%08llX  (unknown)\n", (unsigned long long)mask);
+        continue;
+      }
+
+      const std::string_view bit_name = db.name (bits [named++]);
+      fprintf (out, "  * 0x%08llX  %.*s\n", (unsigned long long)mask, GLV_FMT_STR (bit_name));
+    }
+  }
+}
+
+// Everything an API version makes available, commands first
+void print_available (FILE* out, const glv_db& db, std::string_view version, const std::vector <glv_id>& matches)
+{
+  size_t num_commands = 0;
+  while (num_commands < matches.size () && db.names [matches [num_commands]].command != GLV_NONE)
+    ++num_commands;
+
+  fprintf (out, "--------------------------------\n");
+  fprintf (out, " >> Available: %.*s has %zu command%s and %zu enum%s\n\n", GLV_FMT_STR (version),
+                num_commands, num_commands != 1 ? "s" : "", matches.size () - num_commands, matches.size () - num_commands != 1 ? "s" : "");
+
+  for (size_t i = 0; i < matches.size (); i++) {
+    fprintf (out, "  * %-56.*s", GLV_FMT_STR (db.name (matches [i])));
+    print_name_kinds (out, db, matches [i]);
+    fprintf (out, "\n");
+  }
+}
+
+// Each match with where it comes from and its lifecycle
+void print_matches (FILE* out, const glv_db& db, std::string_view pattern, const std::vector <glv_id>& matches)
+{
+  fprintf (out, "--------------------------------\n");
+  fprintf (out, " >> Pattern: %.*s matches %zu names\n", GLV_FMT_STR (pattern), matches.size ());
+
+  fprintf (out, "\n");
+
+  for (size_t i = 0; i < matches.size (); i++) {
+    fprintf (out, " >> %-56.*s", GLV_FMT_STR (db.name (matches [i])));
+    print_name_kinds (out, db, matches [i]);
+    fprintf (out, "\n");
+
+    print_providers (out, db, matches [i]);
+    print_lifecycle (out, db, matches [i]);
+
+    // print_providers already ends with a blank line when there is nothing after it
+    if (i + 1 < matches.size () && (find_actions (db, matches [i]).count != 0 || find_ext_reqs (db, matches [i]).count == 0))
+      fprintf (out, "\n");
+  }
+}
+
+
+//
+// Embedded registry
+//
+//   'glvs embed' writes the tables of a registry out as constexpr C++ arrays; building glvs with
+//     -DGLVS_EMBEDDED_REGISTRY then compiles them in, so queries need no file I/O or parsing at all:
+//
+//       glvs embed gl.xml glvs_registry.h
+//       c++ -std=c++17 -O2 -pthread -DGLVS_EMBEDDED_REGISTRY glvs.cpp -o glvs
+//
+// The string blob is emitted as unsigned char: a registry byte above 0x7F written as a negative literal
+//   would be a narrowing error wherever char is unsigned (ARM, PowerPC)
+void emit_record (FILE* out, char c)
+{
+  fprintf (out, "%u", (unsigned)(unsigned char)c);
+}
+
+void emit_record (FILE* out, uint32_t value)
+{
+  fprintf (out, "%uu", value);
+}
+
+void emit_record (FILE* out, uint64_t value)
+{
+  fprintf (out, "0x%llXull", (unsigned long long)value);
+}
+
+void emit_record (FILE* out, glv_str str)
+{
+  fprintf (out, "{%u,%u}", str.offset, str.length);
+}
+
+void emit_record (FILE* out, const glv_name_rec& name)
+{
+  fputc ('{', out);
+  emit_record (out, name.text);
+  fprintf (out, ",%uu,%uu,%uu,%uu,%uu,%u,%u,%u,%u,%u,%u}", name.command, name.enum_id, name.feature, name.extension, name.group,
+                                                           name.first_action,   name.num_actions,
+                                                           name.first_provider, name.num_providers,
+                                                           name.first_group,    name.num_groups);
+}
+
+void emit_record (FILE* out, const glv_command_rec& command)
+{
+  fprintf (out, "{%uu,%uu,%uu,%u,%u,", command.name, command.alias, command.alias_class,
+                                       command.first_param, command.num_params);
+  emit_record (out, command.proto);
+  fputc (',', out);
+  emit_record (out, command.ptype);
+  fputc ('}', out);
+}
+
+void emit_record (FILE* out, const glv_param_rec& param)
+{
+  fputc ('{', out);
+  emit_record (out, param.type);
+  fputc (',', out);
+  emit_record (out, param.ptype);
+  fputc (',', out);
+  emit_record (out, param.name);
+  fputc ('}', out);
+}
+
+void emit_record (FILE* out, const glv_type_rec& type)
+{
+  fprintf (out, "{%u,", type.name);
+  emit_record (out, type.api);
+  fputc (',', out);
+  emit_record (out, type.text);
+  fprintf (out, ",%uu}", type.required_type);
+}
+
+void emit_record (FILE* out, const glv_enum_rec& enum_entry)
+{
+  fprintf (out, "{0x%llXull,%u,%uu,%u,", (unsigned long long)enum_entry.value, enum_entry.name, enum_entry.alias, enum_entry.flags);
+  emit_record (out, enum_entry.api);
+  fputc ('}', out);
+}
+
+void emit_record (FILE* out, const glv_feature_rec& feature)
+{
+  fprintf (out, "{%u,", feature.name);
+  emit_record (out, feature.api);
+  fputc (',', out);
+  emit_record (out, feature.number);
+  fprintf (out, ",%u,%u}", feature.first_set, feature.num_sets);
+}
+
+void emit_record (FILE* out, const glv_extension_rec& extension)
+{
+  fprintf (out, "{%u,%u}", extension.name, extension.supported);
+}
+
+void emit_record (FILE* out, const glv_action_rec& action)
+{
+  fprintf (out, "{%u,%u,", action.feature, action.verb);
+  emit_record (out, action.profile);
+  fputc ('}', out);
+}
+
+void emit_record (FILE* out, const glv_feature_set_rec& set)
+{
+  fprintf (out, "{%u,", set.verb);
+  emit_record (out, set.profile);
+  fprintf (out, ",%u}", set.first_word);
+}
+
+void emit_record (FILE* out, const glv_provider_rec& provider)
+{
+  fprintf (out, "{%u,%u}", provider.extension, provider.apis);
+}
+
+void emit_record (FILE* out, const glv_group_rec& group)
+{
+  fputc ('{', out);
+  emit_record (out, group.name);
+  fprintf (out, ",%u,%u,%u,%uu}", group.flags, group.first_member, group.num_members, group.first_bit);
+}
+
+void emit_record (FILE* out, const glv_alias_rec& alias_class)
+{
+  fprintf (out, "{%u,%u,%u}", alias_class.canonical, alias_class.first_member, alias_class.num_members);
+}
+
+// Arrays cannot be empty, so an empty table still gets one (uncounted) zero record
+template <typename T>
+void emit_table (FILE* out, const char* type, const char* table, const glv_table <T>& records)
+{
+  fprintf (out, "static constexpr uint32_t glv_embedded_%s_count = %u;\n", table, records.count);
+  fprintf (out, "static constexpr %s glv_embedded_%s [%u] = {", sizeof (T) == 1 ? "unsigned char" : type, table, std::max (records.count, 1u));
+
+  const uint32_t per_line = sizeof (T) == 1 ? 24 : sizeof (T) <= sizeof (uint32_t) ? 12 : 4;
+
+  for (uint32_t i = 0; i < records.count; i++) {
+    fputs (i % per_line == 0 ? "\n  " : " ", out);
+    emit_record (out, records [i]);
+    fputc (',', out);
+  }
+
+  if (records.count == 0)
+    fputs ("\n  { }", out);
+
+  fputs ("\n};\n\n", out);
+}
+
+bool write_embedded_tables (const char* path, const glv_db& db, const glv_file& source, const char* source_path)
+{
+  FILE* out = fopen (path, "wb");
+  if (out == NULL)
+    return false;
+
+  fprintf (out, "// Generated by 'glvs embed' from %s; do not edit.\n"
+                "//   Included by glvs.cpp when built with -DGLVS_EMBEDDED_REGISTRY.\n\n", source_path);
+
+  fprintf (out, "static constexpr const char* glv_embedded_source      = \"%s\";\n", source_path);
+  fprintf (out, "static constexpr uint64_t    glv_embedded_source_hash = 0x%016llXull;\n",
+                  (unsigned long long)hash_bytes (source.data, source.size));
+  fprintf (out, "static constexpr uint64_t    glv_embedded_source_size = %lluull;\n\n", (unsigned long long)source.size);
+
+#define GLV_DB_EMIT_TABLE(type, table) emit_table (out, #type, #table, db.table);
+  GLV_DB_TABLES (GLV_DB_EMIT_TABLE)
+#undef GLV_DB_EMIT_TABLE
+
+  return fclose (out) == 0;
+}
+
+#if defined (GLVS_EMBEDDED_REGISTRY)
+# include "glvs_registry.h"
+
+glv_db embedded_db (void)
+{
+  glv_db db;
+#define GLV_DB_EMBED_TABLE(type, table) db.table.data = (const type *)glv_embedded_##table; db.table.count = glv_embedded_##table##_count;
+  GLV_DB_TABLES (GLV_DB_EMBED_TABLE)
+#undef GLV_DB_EMBED_TABLE
+  return db;
+}
+#endif
+
+
+// What parsing a registry took from rapidxml, gathered for --stats
+struct glv_element_stats {
+  size_t nodes;
+  size_t attributes;
+};
+
+struct glv_parse_stats {
+  size_t pool_static;    // memory_pool's inline block, there whether or not it is used
+  size_t pool_dynamic;   // Bytes of the blocks allocated once the inline block ran out
+  size_t pool_blocks;
+  size_t pool_estimated; // Nodes and attributes times their sizes; memory_pool does not expose what it handed out
+  size_t nodes;
+  size_t attributes;
+  std::map <std::string, glv_element_stats> elements; // By element name; text is "#text"
+};
+
+// memory_pool's allocator is a plain function, so the stats it counts into are per thread
+thread_local glv_parse_stats* glv_pool_stats = NULL;
+
+void* allocate_pool_block (size_t size)
+{
+  if (glv_pool_stats != NULL) {
+    glv_pool_stats->pool_dynamic += size;
+    glv_pool_stats->pool_blocks++;
+  }
+  return ::operator new (size);
+}
+
+void free_pool_block (void* block)
+{
+  ::operator delete (block);
+}
+
+void count_elements (const xml_node<>* parent, glv_parse_stats& stats)
+{
+  for (const xml_node<>* node = parent->first_node (); node != NULL; node = node->next_sibling ()) {
+    glv_element_stats& element = stats.elements [node->type () == node_element ? std::string (xml_name (node)) : std::string ("#text")];
+
+    size_t attributes = 0;
+    for (const xml_attribute<>* attribute = node->first_attribute (); attribute != NULL; attribute = attribute->next_attribute ())
+      attributes++;
+
+    element.nodes++;
+    element.attributes += attributes;
+    stats.nodes++;
+    stats.attributes += attributes;
+
+    count_elements (node, stats);
+  }
+}
+
+// Parses registry_path and builds its tables into builder; fills stats (unless NULL) from the document
+bool load_xml_db (const char* registry_path, glv_file& xml_file, glv_db_builder& builder, double& load_ms, double& parse_ms, double& index_ms,
+                  glv_parse_stats* stats)
+{
+  xml_document<> glv_xml;
+
+  if (stats != NULL) {
+    *stats = glv_parse_stats ();
+    stats->pool_static = RAPIDXML_STATIC_POOL_SIZE;
+    glv_pool_stats     = stats;
+    glv_xml.set_allocator (allocate_pool_block, free_pool_block);
+  }
+
+  std::chrono::steady_clock::time_point phase = std::chrono::steady_clock::now ();
+
+  if (! load_file (registry_path, xml_file))
+    return false;
+
+  load_ms = elapsed_ms (phase);
+  phase   = std::chrono::steady_clock::now ();
+
+  // rapidxml's interface is not const-correct, but these flags leave the buffer untouched
+  glv_xml.parse <glv_parse_flags> (const_cast <char *> (xml_file.data));
+
+  parse_ms = elapsed_ms (phase);
+  phase    = std::chrono::steady_clock::now ();
+
+  if (! build_db (builder, glv_xml.first_node ("registry")))
+    return false;
+
+  index_ms = elapsed_ms (phase);
+
+  // Counted after the timed phases so that --stats does not skew them
+  if (stats != NULL) {
+    glv_pool_stats = NULL;
+    count_elements (&glv_xml, *stats);
+    stats->pool_estimated = stats->nodes * sizeof (xml_node<>) + stats->attributes * sizeof (xml_attribute<>);
+  }
+
+  return true;
+}
+
+// Where a registry's tables came from and what it cost
+enum glv_db_source {
+  GLV_DB_EMBEDDED,
+  GLV_DB_SNAPSHOT,
+  GLV_DB_XML
+};
+
+struct glv_load_info {
+  glv_db_source       source;
+  glv_snapshot_status snapshot;
+  std::string         path;     // File the tables came from (the snapshot or the XML)
+  size_t              bytes;
+  bool                mapped;
+  double              load_ms;
+  double              parse_ms;
+  double              index_ms;
+};
+
+// A loaded registry and whatever owns its tables. Nothing in it changes once open_registry returns, so
+//   any number of threads may query db at the same time.
+struct glv_registry {
+  glv_db         db;
+  glv_file       file;    // The snapshot the tables point into, when they came from one
+  glv_db_builder builder; // Owns the tables when they were built from XML
+  glv_load_info  info;
+
+  glv_registry (void)
+  {
+    file.data = NULL;
+  }
+
+  ~glv_registry (void)
+  {
+    unload_file (file);
+  }
+
+  glv_registry            (const glv_registry&) = delete;
+  glv_registry& operator= (const glv_registry&) = delete;
+};
+
+// Fills registry: the embedded tables unless a registry was named, otherwise its snapshot if that is
+//   fresh, otherwise the XML itself. stats (unless NULL) is only filled when the XML is parsed.
+bool open_registry (const char* registry_path, glv_registry& registry, glv_parse_stats* stats)
+{
+  glv_load_info& info = registry.info;
+
+  info.snapshot = GLV_SNAPSHOT_MISSING;
+  info.bytes    = 0;
+  info.mapped   = false;
+  info.load_ms  = 0.0;
+  info.parse_ms = 0.0;
+  info.index_ms = 0.0;
+
+#if defined (GLVS_EMBEDDED_REGISTRY)
+  if (registry_path == NULL) {
+    info.source = GLV_DB_EMBEDDED;
+    info.path   = glv_embedded_source;
+    registry.db = embedded_db ();
+    return true;
+  }
+#endif
+
+  if (registry_path == NULL)
+    registry_path = "gl.xml";
+
+  const std::string db_path = snapshot_path (registry_path);
+
+  std::chrono::steady_clock::time_point phase = std::chrono::steady_clock::now ();
+
+  info.snapshot = load_snapshot (db_path.c_str (), registry_path, registry.file, registry.db);
+
+  if (info.snapshot == GLV_SNAPSHOT_OK) {
+    info.source  = GLV_DB_SNAPSHOT;
+    info.path    = db_path;
+    info.bytes   = registry.file.size;
+    info.mapped  = registry.file.mapped;
+    info.load_ms = elapsed_ms (phase);
+    return true;
+  }
+
+  // Fall back to the XML when there is no usable snapshot
+  glv_file xml_file;
+  if (! load_xml_db (registry_path, xml_file, registry.builder, info.load_ms, info.parse_ms, info.index_ms, stats))
+    return false;
+
+  info.source = GLV_DB_XML;
+  info.path   = registry_path;
+  info.bytes  = xml_file.size;
+  info.mapped = xml_file.mapped;
+  registry.db = registry.builder.view ();
+
+  // The built tables hold copies of everything they need from the document
+  unload_file (xml_file);
+
+  return true;
+}
+
+void print_load_info (const glv_load_info& info)
+{
+  switch (info.source) {
+    case GLV_DB_EMBEDDED:
+      printf ("Registry: embedded, compiled from '%s'\n\n", info.path.c_str ());
+      break;
+    case GLV_DB_SNAPSHOT:
+      printf ("Registry: %.2f MiB snapshot '%s' %s in %.3f ms\n\n",
+                info.bytes / (1024.0 * 1024.0), info.path.c_str (), info.mapped ? "mapped" : "read", info.load_ms);
+      break;
+    case GLV_DB_XML:
+      printf ("Registry: %.2f MiB %s in %.2f ms, parsed in %.2f ms, indexed in %.2f ms%s\n\n",
+                info.bytes / (1024.0 * 1024.0), info.mapped ? "mapped" : "read",
+                  info.load_ms, info.parse_ms, info.index_ms, info.snapshot == GLV_SNAPSHOT_STALE ? " (snapshot is stale)" : "");
+      break;
+  }
+}
+
+// glvs compile [gl.xml [gl.glvsdb]]
+// glvs embed   [gl.xml [glvs_registry.h]]
+int compile (const int argc, const char** argv, bool embed)
+{
+  const char*       registry_path = argc > 2 ? argv [2] : "gl.xml";
+  const std::string out_path      = argc > 3 ? std::string (argv [3]) :
+                                      embed ? std::string ("glvs_registry.h") : snapshot_path (registry_path);
+
+  glv_file       xml_file;
+  glv_db_builder builder;
+  double         load_ms, parse_ms, index_ms;
+
+  if (! load_xml_db (registry_path, xml_file, builder, load_ms, parse_ms, index_ms, NULL)) {
+    printf (" @ ERROR: Cannot open '%s'\n", registry_path);
+    return -2;
+  }
+
+  const glv_db db = builder.view ();
+
+  const bool written = embed ? write_embedded_tables (out_path.c_str (), db, xml_file, registry_path) :
+                               write_snapshot        (out_path.c_str (), db, xml_file, registry_path);
+  if (! written) {
+    printf (" @ ERROR: Cannot write '%s'\n", out_path.c_str ());
+    return -2;
+  }
+
+  printf ("Compiled '%s' -> '%s': %u names, %u commands, %u enums, %u features, %u extensions\n",
+            registry_path, out_path.c_str (), db.names.count, db.commands.count, db.enums.count,
+                                              db.features.count, db.extensions.count);
+
+  unload_file (xml_file);
+
+  return 0;
+}
+
+enum glv_query_status {
+  GLV_QUERY_COMMAND,
+  GLV_QUERY_ENUM,
+  GLV_QUERY_PREFIX,
+  GLV_QUERY_PATTERN,
+  GLV_QUERY_VALUE,
+  GLV_QUERY_BITS,
+  GLV_QUERY_AVAILABLE,
+  GLV_QUERY_NOT_FOUND
+};
+
+const char* glv_query_status_names [] = { "command", "enum", "prefix", "pattern", "value", "bits", "available", "not found" };
+
+struct glv_query {
+  glv_query_status     status;
+  glv_id               id;      // The command or enum that was found
+  std::vector <glv_id> matches; // Names a prefix or pattern matched, groups a mask was decoded in, or what a version makes available
+  std::string          error;   // Why a pattern did not compile
+  unsigned long long   value;   // What a numeric query asked for
+};
+
+// "0x8B31", "36281" or "-1"; names never start with a digit
+bool is_value_query (std::string_view name, unsigned long long& value)
+{
+  return (! name.empty ()) && (isdigit ((uint8_t)name [0]) || name [0] == '-') && parse_integer (name, value);
+}
+
+// "/GL_.*_ARB$/" is a regular expression
+bool is_regex_query (std::string_view name)
+{
+  return name.size () >= 2 && name.front () == '/' && name.back () == '/';
+}
+
+// A single trailing '*' asks for every name that starts with the rest, e.g. "glTexStorage*"
+bool is_prefix_query (std::string_view name)
+{
+  return (! name.empty ()) && name.find_first_of ("*?[") == name.size () - 1 && name.back () == '*';
+}
+
+// Any other wildcard makes a glob, e.g. "glUniform*fv"
+bool is_glob_query (std::string_view name)
+{
+  return name.find_first_of ("*?[") != std::string_view::npos && (! is_prefix_query (name));
+}
+
+// "0x4100:ClearBufferMask" decodes a mask in one group, "0x4100:" in whichever bitmask groups explain it best
+bool is_bits_query (std::string_view name, unsigned long long& value, std::string_view& group)
+{
+  const size_t colon = name.find (':');
+  if (colon == std::string_view::npos)
+    return false;
+
+  group = name.substr (colon + 1);
+  return is_value_query (name.substr (0, colon), value);
+}
+
+// "gl:4.5:core", "gles2:3.2" or "gl:3.0" asks for everything an API version (and profile) makes available
+bool is_available_query (std::string_view name, std::string_view& api, double& version, std::string_view& profile)
+{
+  const size_t colon = name.find (':');
+  if (colon == 0 || colon == std::string_view::npos || (! isalpha ((uint8_t)name [0])))
+    return false;
+
+  api     = name.substr (0, colon);
+  profile = name.substr (colon + 1);
+
+  const std::string_view number = profile.substr (0, std::min (profile.find (':'), profile.size ()));
+  if (number.empty () || number.find_first_not_of ("0123456789.") != std::string_view::npos)
+    return false;
+
+  version = parse_version (number);
+  profile.remove_prefix (std::min (number.size () + 1, profile.size ()));
+  return true;
+}
+
+// Bitmask groups that name at least one bit of value (or all of it) and leave the fewest bits unnamed
+std::vector <glv_id> find_bitmask_groups (const glv_db& db, uint64_t value)
+{
+  std::vector <glv_id> best;
+  uint32_t             fewest_unknown = 65;
+
+  for (glv_id group = 0; group < db.groups.count; group++) {
+    if (! (db.groups [group].flags & GLV_GROUP_BITMASK))
+      continue;
+
+    uint64_t unknown;
+    if (decode_bits (db, group, value, unknown).empty () && find_group_members (db, group, value).empty ())
+      continue;
+
+    const uint32_t num_unknown = count_bits (unknown);
+    if (num_unknown < fewest_unknown) {
+      fewest_unknown = num_unknown;
+      best.clear ();
+    }
+    if (num_unknown == fewest_unknown)
+      best.push_back (group);
+  }
+
+  return best;
+}
+
+// Commands take precedence over enums of the same name
+glv_query_status find_query (const glv_db& db, std::string_view name, glv_query& query)
+{
+  query.id = GLV_NONE;
+  query.matches.clear ();
+  query.error.clear   ();
+
+  std::string_view group_name;
+  if (is_bits_query (name, query.value, group_name)) {
+    if (group_name.empty ()) {
+      query.matches = find_bitmask_groups (db, query.value);
+    } else {
+      const glv_id group = find_group (db, group_name);
+      if (group == GLV_NONE)
+        query.error = "there is no group named '" + std::string (group_name) + "'";
+      else if (! (db.groups [group].flags & GLV_GROUP_BITMASK))
+        query.error = "'" + std::string (group_name) + "' is not a bitmask group";
+      else
+        query.matches.push_back (group);
+    }
+
+    return query.status = query.matches.empty () ? GLV_QUERY_NOT_FOUND : GLV_QUERY_BITS;
+  }
+
+  std::string_view api, profile;
+  double           version;
+  if (is_available_query (name, api, version, profile)) {
+    std::vector <uint64_t> available;
+    if (! is_known_profile (db, profile))
+      query.error = "no feature names a '" + std::string (profile) + "' profile";
+    else if (find_available (db, api, version, profile, available) == 0)
+      query.error = "there is no " + std::string (api) + " feature up to that version";
+
+    // Commands, then enums, each in registry order
+    for (int pass = 0; pass < 2 && query.error.empty (); pass++) {
+      for (glv_id id = 0; id < db.names.count; id++) {
+        if (available [id / 64] == 0) {
+          id |= 63; // Skip the rest of an empty word
+          continue;
+        }
+
+        const glv_name_rec& record = db.names [id];
+        if (((available [id / 64] >> (id % 64)) & 1) &&
+            (pass == 0 ? record.command != GLV_NONE : (record.command == GLV_NONE && record.enum_id != GLV_NONE)))
+          query.matches.push_back (id);
+      }
+    }
+
+    return query.status = query.matches.empty () ? GLV_QUERY_NOT_FOUND : GLV_QUERY_AVAILABLE;
+  }
+
+  if (is_value_query (name, query.value))
+    return query.status = find_enums_by_value (db, query.value).count != 0 ? GLV_QUERY_VALUE : GLV_QUERY_NOT_FOUND;
+
+  if (is_regex_query (name) || is_glob_query (name)) {
+    const std::string pattern = is_regex_query (name) ? std::string (name.substr (1, name.size () - 2)) : glob_to_regex (name);
+    glv_regex         regex;
+
+    if (compile_regex (pattern, regex, query.error))
+      query.matches = find_matching_names (db, regex);
+
+    return query.status = query.matches.empty () ? GLV_QUERY_NOT_FOUND : GLV_QUERY_PATTERN;
+  }
+
+  if (is_prefix_query (name)) {
+    const glv_table <glv_id> matches = find_names_by_prefix (db, name.substr (0, name.size () - 1));
+
+    for (uint32_t i = 0; i < matches.count; i++) {
+      if (is_named_entity (db, matches [i]))
+        query.matches.push_back (matches [i]);
+    }
+
+    return query.status = query.matches.empty () ? GLV_QUERY_NOT_FOUND : GLV_QUERY_PREFIX;
+  }
+
+  query.id = find_command (db, name);
+  if (query.id != GLV_NONE)
+    return query.status = GLV_QUERY_COMMAND;
+
+  query.id = find_enum (db, name);
+  if (query.id != GLV_NONE)
+    return query.status = GLV_QUERY_ENUM;
+
+  return query.status = GLV_QUERY_NOT_FOUND;
+}
+
+void print_result (FILE* out, const glv_db& db, std::string_view name, const glv_query& query)
+{
+  switch (query.status) {
+    case GLV_QUERY_COMMAND:
+      print_command (out, db, query.id);
+      break;
+    case GLV_QUERY_ENUM:
+      print_enum (out, db, query.id);
+      break;
+    case GLV_QUERY_PREFIX:
+      print_prefix (out, db, name.substr (0, name.size () - 1), query.matches);
+      break;
+    case GLV_QUERY_PATTERN:
+      print_matches (out, db, name, query.matches);
+      break;
+    case GLV_QUERY_VALUE:
+      print_value (out, db, query.value);
+      break;
+    case GLV_QUERY_BITS:
+      print_bits (out, db, query.value, query.matches);
+      break;
+    case GLV_QUERY_AVAILABLE:
+      print_available (out, db, name, query.matches);
+      break;
+    case GLV_QUERY_NOT_FOUND:
+      if (! query.error.empty ()) {
+        fprintf (out, "--------------------------------\n"
+                      " @ ERROR: '%.*s': %s\n",
+                      GLV_FMT_STR (name), query.error.c_str ());
+        break;
+      }
+      fprintf (out, "--------------------------------\n"
+                    " @ ERROR: '%.*s' Not Found In GL Registry!\n",
+                    GLV_FMT_STR (name));
+      if (! (is_prefix_query (name) || is_glob_query (name) || is_regex_query (name) || isdigit ((uint8_t)name [0])))
+        print_suggestions (out, db, name);
+      break;
+  }
+}
+
+glv_query_status print_query (const glv_db& db, std::string_view name)
+{
+  glv_query query;
+  find_query   (db, name, query);
+  print_result (stdout, db, name, query);
+
+  return query.status;
+}
+
+
+//
+// JSON output
+//
+//   --json answers each name with one line of JSON (NDJSON) carrying what the text layout shows: the
+//     signature, providers, lifecycle and aliases of a command, the value and groups of an enum, and
+//     so on. Output is assembled in a glv_writer and reaches stdio in large blocks.
+//
+enum glv_format {
+  GLV_FORMAT_TEXT,
+  GLV_FORMAT_JSON
+};
+
+// Bytes a glv_writer collects before passing them on in a single fwrite
+const size_t glv_writer_block = 1 << 16;
+
+struct glv_writer {
+  FILE*       out;
+  std::string buffer;
+
+  explicit glv_writer (FILE* file) : out (file)
+  {
+    buffer.reserve (glv_writer_block + 4096);
+  }
+};
+
+void flush_writer (glv_writer& writer)
+{
+  fwrite (writer.buffer.data (), 1, writer.buffer.size (), writer.out);
+  writer.buffer.clear ();
+}
+
+void write_text (glv_writer& writer, std::string_view text)
+{
+  writer.buffer.append (text.data (), text.size ());
+  if (writer.buffer.size () >= glv_writer_block)
+    flush_writer (writer);
+}
+
+void write_json_string (glv_writer& writer, std::string_view text)
+{
+  std::string& buffer = writer.buffer;
+
+  buffer += '"';
+  for (size_t i = 0; i < text.size (); i++) {
+    const uint8_t c = (uint8_t)text [i];
+    if (c == '"' || c == '\\') {
+      buffer += '\\';
+      buffer += (char)c;
+    } else if (c < 0x20) {
+      char escape [8];
+      snprintf (escape, sizeof (escape), "\\u%04x", c);
+      buffer += escape;
+    } else {
+      buffer += (char)c;
+    }
+  }
+  buffer += '"';
+}
+
+// ,"key":"text"
+void write_json_field (glv_writer& writer, const char* key, std::string_view text)
+{
+  writer.buffer += ",\"";
+  writer.buffer += key;
+  writer.buffer += "\":";
+  write_json_string (writer, text);
+}
+
+void write_json_value (glv_writer& writer, const char* key, unsigned long long value)
+{
+  char text [32];
+  snprintf (text, sizeof (text), "0x%04llX", value);
+  write_json_field (writer, key, text);
+}
+
+// ,"key":["NAME",...]
+void write_json_names (glv_writer& writer, const char* key, const glv_db& db, const glv_id* names, size_t count)
+{
+  writer.buffer += ",\"";
+  writer.buffer += key;
+  writer.buffer += "\":[";
+  for (size_t i = 0; i < count; i++) {
+    if (i != 0)
+      writer.buffer += ',';
+    write_json_string (writer, db.name (names [i]));
+  }
+  writer.buffer += ']';
+}
+
+void write_json_groups (glv_writer& writer, const glv_db& db, glv_id name)
+{
+  const glv_table <glv_id> groups = find_groups (db, name);
+
+  writer.buffer += ",\"groups\":[";
+  for (uint32_t i = 0; i < groups.count; i++) {
+    if (i != 0)
+      writer.buffer += ',';
+    write_json_string (writer, db.str (db.groups [groups [i]].name));
+  }
+  writer.buffer += ']';
+}
+
+// ,"providers":[...],"lifecycle":[...]
+void write_json_history (glv_writer& writer, const glv_db& db, glv_id name)
+{
+  const glv_table <glv_provider_rec> providers = find_ext_reqs (db, name);
+
+  writer.buffer += ",\"providers\":[";
+  for (uint32_t i = 0; i < providers.count; i++) {
+    writer.buffer += i != 0 ? ",{\"extension\":" : "{\"extension\":";
+    write_json_string (writer, db.name (db.extensions [providers [i].extension].name));
+    write_json_field  (writer, "apis", format_api_mask (providers [i].apis));
+    writer.buffer += '}';
+  }
+
+  const glv_table <glv_action_rec> actions = find_actions (db, name);
+
+  writer.buffer += "],\"lifecycle\":[";
+  for (uint32_t i = 0; i < actions.count; i++) {
+    const glv_feature_rec& feature = db.features [actions [i].feature];
+    writer.buffer += i != 0 ? ",{\"verb\":" : "{\"verb\":";
+    write_json_string (writer, glv_verb_names [actions [i].verb]);
+    write_json_field  (writer, "feature", db.name (feature.name));
+    write_json_field  (writer, "api",     db.str  (feature.api));
+    write_json_field  (writer, "number",  db.str  (feature.number));
+    write_json_field  (writer, "profile", db.str  (actions [i].profile));
+    writer.buffer += '}';
+  }
+  writer.buffer += ']';
+}
+
+// A declared type without the space that separated it from the name: "GLenum " -> "GLenum"
+std::string_view json_type (std::string_view type)
+{
+  return type.substr (0, type.find_last_not_of (" \t\r\n") + 1);
+}
+
+void write_json_command (glv_writer& writer, const glv_db& db, glv_id command_id)
+{
+  const glv_command_rec& command = db.commands [command_id];
+
+  write_json_field (writer, "name",      db.name (command.name));
+  write_json_field (writer, "signature", format_signature (db, command_id));
+  write_json_field (writer, "return",    json_type (db.str (command.proto)));
+
+  writer.buffer += ",\"params\":[";
+  for (uint32_t i = 0; i < command.num_params; i++) {
+    const glv_param_rec& param = db.params [command.first_param + i];
+    writer.buffer += i != 0 ? ",{\"type\":" : "{\"type\":";
+    write_json_string (writer, json_type (db.str (param.type)));
+    write_json_field  (writer, "name", db.str (param.name));
+    writer.buffer += '}';
+  }
+  writer.buffer += ']';
+
+  // Every other command of its alias class, and which of them is canonical
+  std::vector <glv_id> aliases;
+  const glv_alias_rec* alias_class = find_command_aliases (db, command_id);
+  if (alias_class != NULL) {
+    for (uint32_t i = 0; i < alias_class->num_members; i++) {
+      const glv_id member = db.alias_members [alias_class->first_member + i];
+      if (member != command_id)
+        aliases.push_back (db.commands [member].name);
+    }
+    write_json_field (writer, "canonical", db.name (db.commands [alias_class->canonical].name));
+  }
+  write_json_names   (writer, "aliases", db, aliases.data (), aliases.size ());
+  write_json_history (writer, db, command.name);
+}
+
+void write_json_enum (glv_writer& writer, const glv_db& db, glv_id enum_id)
+{
+  const glv_enum_rec& enum_entry = db.enums [enum_id];
+
+  write_json_field  (writer, "name", db.name (enum_entry.name));
+  write_json_value  (writer, "value", enum_entry.value);
+  write_json_groups (writer, db, enum_entry.name);
+
+  std::vector <glv_id>     aliases;
+  const glv_table <glv_id> same_value = find_enums_by_value (db, enum_entry.value);
+  for (uint32_t i = 0; i < same_value.count; i++) {
+    const glv_id alias = db.enums [same_value [i]].name;
+    if (alias != enum_entry.name && std::find (aliases.begin (), aliases.end (), alias) == aliases.end ())
+      aliases.push_back (alias);
+  }
+  write_json_names   (writer, "aliases", db, aliases.data (), aliases.size ());
+  write_json_history (writer, db, enum_entry.name);
+}
+
+// {"name":...,"kinds":[...]} for each match
+void write_json_matches (glv_writer& writer, const glv_db& db, const std::vector <glv_id>& matches)
+{
+  writer.buffer += ",\"matches\":[";
+  for (size_t i = 0; i < matches.size (); i++) {
+    const glv_name_rec& record = db.names [matches [i]];
+    writer.buffer += i != 0 ? ",{\"name\":" : "{\"name\":";
+    write_json_string (writer, db.name (matches [i]));
+    writer.buffer += ",\"kinds\":[";
+    std::string kinds;
+    if (record.command   != GLV_NONE) kinds += ",\"command\"";
+    if (record.enum_id   != GLV_NONE) kinds += ",\"enum\"";
+    if (record.extension != GLV_NONE) kinds += ",\"extension\"";
+    if (record.feature   != GLV_NONE) kinds += ",\"feature\"";
+    writer.buffer.append (kinds, kinds.empty () ? 0 : 1, std::string::npos);
+    writer.buffer += "]}";
+  }
+  writer.buffer += ']';
+}
+
+void write_json_bits (glv_writer& writer, const glv_db& db, unsigned long long value, const std::vector <glv_id>& groups)
+{
+  write_json_value (writer, "value", value);
+
+  writer.buffer += ",\"groups\":[";
+  for (size_t i = 0; i < groups.size (); i++) {
+    uint64_t                   unknown;
+    const std::vector <glv_id> bits  = decode_bits        (db, groups [i], value, unknown);
+    const std::vector <glv_id> whole = find_group_members (db, groups [i], value);
+
+    writer.buffer += i != 0 ? ",{\"group\":" : "{\"group\":";
+    write_json_string (writer, db.str (db.groups [groups [i]].name));
+    write_json_names  (writer, "equals", db, whole.data (), whole.size ());
+    write_json_names  (writer, "bits",   db, bits.data (),  bits.size ());
+    write_json_value  (writer, "unknown", unknown);
+    writer.buffer += '}';
+  }
+  writer.buffer += ']';
+}
+
+// One line: {"query":NAME,"status":...} and whatever the status has to say, e.g. the fields of the command
+void write_json_result (glv_writer& writer, const glv_db& db, std::string_view name, const glv_query& query)
+{
+  writer.buffer += "{\"query\":";
+  write_json_string (writer, name);
+  write_json_field  (writer, "status", glv_query_status_names [query.status]);
+
+  switch (query.status) {
+    case GLV_QUERY_COMMAND:
+      write_json_command (writer, db, query.id);
+      break;
+    case GLV_QUERY_ENUM:
+      write_json_enum (writer, db, query.id);
+      break;
+    case GLV_QUERY_PREFIX:
+    case GLV_QUERY_PATTERN:
+    case GLV_QUERY_AVAILABLE:
+      write_json_matches (writer, db, query.matches);
+      break;
+    case GLV_QUERY_VALUE: {
+      write_json_value (writer, "value", query.value);
+      writer.buffer += ",\"enums\":[";
+      const glv_table <glv_id> enums = find_enums_by_value (db, query.value);
+      for (uint32_t i = 0; i < enums.count; i++) {
+        const glv_enum_rec& record = db.enums [enums [i]];
+        writer.buffer += i != 0 ? ",{\"name\":" : "{\"name\":";
+        write_json_string (writer, db.name (record.name));
+        write_json_field  (writer, "api", db.str (record.api));
+        write_json_groups (writer, db, record.name);
+        writer.buffer += '}';
+      }
+      writer.buffer += ']';
+      break;
+    }
+    case GLV_QUERY_BITS:
+      write_json_bits (writer, db, query.value, query.matches);
+      break;
+    case GLV_QUERY_NOT_FOUND:
+      if (! query.error.empty ())
+        write_json_field (writer, "error", query.error);
+      if (query.error.empty () && (! (is_prefix_query (name) || is_glob_query (name) || is_regex_query (name) || isdigit ((uint8_t)name [0])))) {
+        const std::vector <glv_suggestion> suggestions = find_similar_names (db, name);
+        writer.buffer += ",\"suggestions\":[";
+        for (size_t i = 0; i < suggestions.size (); i++) {
+          char distance [32];
+          snprintf (distance, sizeof (distance), ",\"distance\":%u}", suggestions [i].distance);
+          writer.buffer += i != 0 ? ",{\"name\":" : "{\"name\":";
+          write_json_string (writer, db.name (suggestions [i].name));
+          writer.buffer += distance;
+        }
+        writer.buffer += ']';
+      }
+      break;
+  }
+
+  write_text (writer, "}\n");
+}
+
+// Next whitespace separated name in a list; false at the end of input
+bool read_name (FILE* in, std::string& name)
+{
+  name.clear ();
+
+  int c = fgetc (in);
+  while (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+    c = fgetc (in);
+
+  while (c != EOF && c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+    name += (char)c;
+    c = fgetc (in);
+  }
+
+  return ! name.empty ();
+}
+
+// Where batch names come from, in command line order
+struct glv_input {
+  const char* value;
+  bool        is_list; // value is a list file ("-" for stdin) rather than a name
+};
+
+struct glv_batch_totals {
+  size_t found;
+  size_t not_found;
+  double query_ms;   // Time spent finding answers, not writing them out
+  double slowest_ms;
+};
+
+// Text goes straight to out's file, JSON through its buffer
+void run_batch_query (glv_writer& out, const glv_db& db, std::string_view name, glv_format format, glv_batch_totals& totals)
+{
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+
+  glv_query query;
+  find_query (db, name, query);
+
+  const double query_ms = elapsed_ms (start);
+  totals.query_ms  += query_ms;
+  totals.slowest_ms = std::max (totals.slowest_ms, query_ms);
+
+  if (format == GLV_FORMAT_JSON) {
+    write_json_result (out, db, name, query);
+  } else {
+    fprintf      (out.out, "== %.*s: %s\n", GLV_FMT_STR (name), glv_query_status_names [query.status]);
+    print_result (out.out, db, name, query);
+    fprintf      (out.out, "\n");
+  }
+
+  if (query.status == GLV_QUERY_NOT_FOUND)
+    ++totals.not_found;
+  else
+    ++totals.found;
+}
+
+// Calls query for every name of every input, in command line order; false if a list cannot be opened
+template <typename Fn>
+bool for_each_input_name (const std::vector <glv_input>& inputs, Fn query)
+{
+  std::string name;
+
+  for (size_t i = 0; i < inputs.size (); i++) {
+    if (! inputs [i].is_list) {
+      query (std::string_view (inputs [i].value));
+      continue;
+    }
+
+    const bool from_stdin = ! strcmp (inputs [i].value, "-");
+    FILE*      list       = from_stdin ? stdin : fopen (inputs [i].value, "r");
+    if (list == NULL) {
+      fprintf (stderr, " @ ERROR: Cannot open list '%s'\n", inputs [i].value);
+      return false;
+    }
+
+    while (read_name (list, name))
+      query (std::string_view (name));
+
+    if (! from_stdin)
+      fclose (list);
+  }
+
+  return true;
+}
+
+int finish_batch (const glv_batch_totals& totals)
+{
+  fflush  (stdout);
+  fprintf (stderr, "%zu names: %zu found, %zu not found\n", totals.found + totals.not_found, totals.found, totals.not_found);
+
+  return totals.not_found != 0 ? -1 : 0;
+}
+
+// Answers every name against the one registry already loaded, streaming results in input order; -2 if a
+//   list cannot be opened, otherwise 0 with totals for finish_batch
+int run_batch (const glv_db& db, const std::vector <glv_input>& inputs, glv_format format, glv_batch_totals& totals)
+{
+  glv_writer out (stdout);
+
+  totals = glv_batch_totals ();
+
+  if (! for_each_input_name (inputs, [&db, &out, format, &totals] (std::string_view name) { run_batch_query (out, db, name, format, totals); }))
+    return -2;
+
+  flush_writer (out);
+
+  return 0;
+}
+
+#if ! defined (_WIN32)
+// Names per unit of work in a threaded batch; large enough to amortise the hand-off between threads,
+//   small enough that output starts flowing long before the batch is done
+const size_t glv_batch_chunk_names = 1024;
+
+struct glv_batch_chunk {
+  char*            output;
+  size_t           bytes;
+  glv_batch_totals totals;
+  bool             done;
+};
+
+// Worker threads claim chunks of names in turn and render each into its own buffer, while this thread
+//   writes finished chunks to stdout in input order; db is only ever read. Returns as run_batch does.
+int run_parallel_batch (const glv_db& db, const std::vector <glv_input>& inputs, glv_format format, unsigned num_threads, glv_batch_totals& totals)
+{
+  std::vector <std::string> names;
+  if (! for_each_input_name (inputs, [&names] (std::string_view name) { names.push_back (std::string (name)); }))
+    return -2;
+
+  const size_t num_chunks = (names.size () + glv_batch_chunk_names - 1) / glv_batch_chunk_names;
+
+  std::vector <glv_batch_chunk> chunks (num_chunks);
+  std::atomic <size_t>          next_chunk (0);
+  std::mutex                    done_mutex;
+  std::condition_variable       done_signal;
+
+  auto answer_chunks = [&] () {
+    for (size_t c = next_chunk++; c < num_chunks; c = next_chunk++) {
+      const size_t     first  = c * glv_batch_chunk_names;
+      const size_t     last   = std::min (first + glv_batch_chunk_names, names.size ());
+      glv_batch_totals totals = glv_batch_totals ();
+      char*            output = NULL;
+      size_t           bytes  = 0;
+      FILE*            out    = open_memstream (&output, &bytes);
+
+      if (out != NULL) {
+        glv_writer writer (out);
+        for (size_t i = first; i < last; i++)
+          run_batch_query (writer, db, names [i], format, totals);
+
+        flush_writer (writer);
+        fclose       (out);
+      }
+
+      {
+        std::lock_guard <std::mutex> lock (done_mutex);
+        chunks [c].output = output;
+        chunks [c].bytes  = bytes;
+        chunks [c].totals = totals;
+        chunks [c].done   = true;
+      }
+      done_signal.notify_all ();
+    }
+  };
+
+  for (size_t c = 0; c < num_chunks; c++)
+    chunks [c].done = false;
+
+  std::vector <std::thread> workers;
+  for (unsigned i = 0; i < std::min ((size_t)num_threads, num_chunks); i++)
+    workers.push_back (std::thread (answer_chunks));
+
+  totals = glv_batch_totals ();
+
+  for (size_t c = 0; c < num_chunks; c++) {
+    {
+      std::unique_lock <std::mutex> lock (done_mutex);
+      done_signal.wait (lock, [&chunks, c] () { return chunks [c].done; });
+    }
+
+    fwrite (chunks [c].output, 1, chunks [c].bytes, stdout);
+    free   (chunks [c].output);
+
+    totals.found      += chunks [c].totals.found;
+    totals.not_found  += chunks [c].totals.not_found;
+    totals.query_ms   += chunks [c].totals.query_ms;
+    totals.slowest_ms  = std::max (totals.slowest_ms, chunks [c].totals.slowest_ms);
+  }
+
+  for (size_t i = 0; i < workers.size (); i++)
+    workers [i].join ();
+
+  return 0;
+}
+#endif
+
+
+//
+// Statistics
+//
+//   --stats reports on stderr, once the names are answered, where the registry came from and what each
+//     phase of loading it took (reading the file, parsing, building the indexes) and how long the lookups
+//     took. When the XML was parsed it adds what rapidxml's memory_pool took (its inline block plus any
+//     blocks allocated beyond it, both counted, and an estimate of the part of that in use) and how many
+//     nodes and attributes each element name has. With --json it is one JSON object instead, which also
+//     carries the found and not found counts that are otherwise printed on their own line.
+//
+const char* const glv_db_source_names [] = { "embedded", "snapshot", "xml" };
+
+// Element names, most nodes first
+std::vector <std::pair <std::string, glv_element_stats> > sorted_elements (const glv_parse_stats& stats)
+{
+  std::vector <std::pair <std::string, glv_element_stats> > elements (stats.elements.begin (), stats.elements.end ());
+  std::stable_sort (elements.begin (), elements.end (), [] (const auto& a, const auto& b) { return a.second.nodes > b.second.nodes; });
+  return elements;
+}
+
+void print_stats (FILE* out, const glv_load_info& info, const glv_parse_stats& parse, const glv_batch_totals& totals)
+{
+  const size_t queries = totals.found + totals.not_found;
+
+  fprintf (out, "Stats: %s '%s', %.2f MiB %s\n", glv_db_source_names [info.source], info.path.c_str (),
+                  info.bytes / (1024.0 * 1024.0), info.mapped ? "mapped" : "read");
+  fprintf (out, "  read     %10.3f ms\n", info.load_ms);
+
+  if (info.source == GLV_DB_XML) {
+    fprintf (out, "  parse    %10.3f ms\n", info.parse_ms);
+    fprintf (out, "  index    %10.3f ms\n", info.index_ms);
+  }
+
+  fprintf (out, "  queries  %10.3f ms for %zu names (mean %.2f us, slowest %.2f us)\n", totals.query_ms, queries,
+                  queries != 0 ? totals.query_ms * 1000.0 / queries : 0.0, totals.slowest_ms * 1000.0);
+
+  if (info.source != GLV_DB_XML)
+    return;
+
+  fprintf (out, "  pool     %zu KiB static + %zu KiB in %zu dynamic blocks, about %zu KiB used (estimated)\n",
+                  parse.pool_static / 1024, parse.pool_dynamic / 1024, parse.pool_blocks, parse.pool_estimated / 1024);
+  fprintf (out, "  document %zu nodes, %zu attributes\n\n", parse.nodes, parse.attributes);
+  fprintf (out, "    %-20s %10s %12s\n", "element", "nodes", "attributes");
+
+  const std::vector <std::pair <std::string, glv_element_stats> > elements = sorted_elements (parse);
+  for (size_t i = 0; i < elements.size (); i++)
+    fprintf (out, "    %-20s %10zu %12zu\n", elements [i].first.c_str (), elements [i].second.nodes, elements [i].second.attributes);
+}
+
+void write_json_count (glv_writer& writer, const char* key, size_t count)
+{
+  char text [64];
+  snprintf (text, sizeof (text), ",\"%s\":%zu", key, count);
+  writer.buffer += text;
+}
+
+void write_json_ms (glv_writer& writer, const char* key, double ms)
+{
+  char text [64];
+  snprintf (text, sizeof (text), ",\"%s\":%.4f", key, ms);
+  writer.buffer += text;
+}
+
+void write_json_stats (FILE* out, const glv_load_info& info, const glv_parse_stats& parse, const glv_batch_totals& totals)
+{
+  glv_writer writer (out);
+
+  writer.buffer += "{\"stats\":{\"source\":";
+  write_json_string (writer, glv_db_source_names [info.source]);
+  write_json_field  (writer, "path", info.path);
+  write_json_count  (writer, "bytes", info.bytes);
+  write_json_ms     (writer, "read_ms", info.load_ms);
+
+  if (info.source == GLV_DB_XML) {
+    write_json_ms (writer, "parse_ms", info.parse_ms);
+    write_json_ms (writer, "index_ms", info.index_ms);
+  }
+
+  write_json_count (writer, "queries", totals.found + totals.not_found);
+  write_json_count (writer, "found", totals.found);
+  write_json_count (writer, "not_found", totals.not_found);
+  write_json_ms    (writer, "query_ms", totals.query_ms);
+  write_json_ms    (writer, "slowest_query_ms", totals.slowest_ms);
+
+  if (info.source == GLV_DB_XML) {
+    writer.buffer += ",\"pool\":{\"static\":";
+    writer.buffer += std::to_string (parse.pool_static);
+    write_json_count (writer, "dynamic", parse.pool_dynamic);
+    write_json_count (writer, "blocks", parse.pool_blocks);
+    write_json_count (writer, "used_estimate", parse.pool_estimated);
+    writer.buffer += '}';
+    write_json_count (writer, "nodes", parse.nodes);
+    write_json_count (writer, "attributes", parse.attributes);
+
+    writer.buffer += ",\"elements\":{";
+    const std::vector <std::pair <std::string, glv_element_stats> > elements = sorted_elements (parse);
+    for (size_t i = 0; i < elements.size (); i++) {
+      if (i != 0)
+        writer.buffer += ',';
+      write_json_string (writer, elements [i].first);
+      writer.buffer += ":{\"nodes\":";
+      writer.buffer += std::to_string (elements [i].second.nodes);
+      write_json_count (writer, "attributes", elements [i].second.attributes);
+      writer.buffer += '}';
+    }
+    writer.buffer += '}';
+  }
+
+  write_text   (writer, "}}\n");
+  flush_writer (writer);
+}
+
+//
+// Query daemon
+//
+//   'glvs serve' keeps a registry and its indexes resident and answers batch queries over a Unix domain
+//     socket. While one is listening, 'glvs NAME...' hands its names to the daemon rather than loading
+//     the registry itself, and prints exactly what a local batch would.
+//
+//   Handshake: "registry <identity>\n" first on every connection, where the identity is the canonical path
+//                of the client's registry; "mismatch\n" (and a hang-up) if the daemon serves a different one
+//   Request:   one line of whitespace separated names, after "--json " to have them answered in JSON
+//   Response:  "<bytes> <found> <not found>\n" and then <bytes> of batch output, or "stale\n" once the
+//                registry file has changed underneath the daemon (which then exits)
+//
+//   The socket sits next to the registry ("gl.xml" -> "gl.sock") unless $GLVS_SOCKET names one. A shared
+//     socket can serve only one registry, so the handshake sends clients of any other to a local lookup.
+//
+//   Every connection is served on its own thread, so a slow or idle client only holds up itself; one that
+//     sends nothing for glv_daemon_timeout_s is dropped. Clients give up on a daemon that does not answer
+//     within the same time and look the names up themselves.
+//
+std::string socket_path (const char* registry_path)
+{
+  const char* env_path = getenv ("GLVS_SOCKET");
+  if (env_path != NULL && *env_path != '\0')
+    return env_path;
+
+  return replace_extension (registry_path != NULL ? registry_path : "gl.xml", ".sock");
+}
+
+// What open_registry would load for registry_path, the same however the path is spelled
+std::string registry_identity (const char* registry_path)
+{
+#if defined (GLVS_EMBEDDED_REGISTRY)
+  if (registry_path == NULL)
+    return std::string ("embedded ") + glv_embedded_source;
+#endif
+
+  if (registry_path == NULL)
+    registry_path = "gl.xml";
+
+#if ! defined (_WIN32)
+  char* canonical = realpath (registry_path, NULL);
+  if (canonical != NULL) {
+    const std::string identity (canonical);
+    free (canonical);
+    return identity;
+  }
+#endif
+
+  return registry_path;
+}
+
+#if ! defined (_WIN32)
+const int glv_daemon_timeout_s = 10;
+
+// Bounds every read and write on fd, so neither end of a connection can block the other indefinitely
+void set_socket_timeouts (int fd)
+{
+  timeval timeout;
+  timeout.tv_sec  = glv_daemon_timeout_s;
+  timeout.tv_usec = 0;
+
+  setsockopt (fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof (timeout));
+  setsockopt (fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof (timeout));
+}
+
+bool write_all (int fd, const char* data, size_t size)
+{
+  while (size != 0) {
+    const ssize_t written = write (fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    data += written;
+    size -= (size_t)written;
+  }
+
+  return true;
+}
+
+// False if the path does not fit in sun_path
+bool socket_address (const std::string& path, sockaddr_un& address)
+{
+  memset (&address, 0, sizeof (address));
+  address.sun_family = AF_UNIX;
+
+  if (path.size () >= sizeof (address.sun_path))
+    return false;
+
+  memcpy (address.sun_path, path.c_str (), path.size () + 1);
+
+  return true;
+}
+
+// -1 when nothing is listening
+int connect_daemon (const std::string& path)
+{
+  sockaddr_un address;
+  if (! socket_address (path, address))
+    return -1;
+
+  const int fd = socket (AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+    return -1;
+
+  set_socket_timeouts (fd);
+
+  if (connect (fd, (const sockaddr *)&address, sizeof (address)) != 0) {
+    close (fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+// identify_file of the registry when it was loaded, so a daemon notices it being regenerated
+struct glv_source_stamp {
+  bool        watched;
+  glv_file_id id;
+};
+
+glv_source_stamp stamp_source (const char* source_path)
+{
+  glv_source_stamp stamp = { false, { 0, 0, 0, 0 } };
+  stamp.watched = source_path != NULL && identify_file (source_path, stamp.id);
+  return stamp;
+}
+
+bool source_changed (const glv_source_stamp& loaded, const char* source_path)
+{
+  if (! loaded.watched)
+    return false;
+
+  const glv_source_stamp current = stamp_source (source_path);
+
+  return (! current.watched) || memcmp (&current.id, &loaded.id, sizeof (glv_file_id)) != 0;
+}
+
+void serve_request (int fd, const glv_db& db, std::string_view request)
+{
+  glv_batch_totals totals = glv_batch_totals ();
+  char*            output = NULL;
+  size_t           bytes  = 0;
+  FILE*            out    = open_memstream (&output, &bytes);
+
+  if (out == NULL)
+    return;
+
+  glv_writer writer (out);
+  glv_format format = GLV_FORMAT_TEXT;
+  if (request.substr (0, 7) == "--json ") {
+    format = GLV_FORMAT_JSON;
+    request.remove_prefix (7);
+  }
+
+  size_t start = 0;
+  while (start < request.size ()) {
+    start = request.find_first_not_of (" \t\r", start);
+    if (start == std::string_view::npos)
+      break;
+
+    size_t end = request.find_first_of (" \t\r", start);
+    if (end == std::string_view::npos)
+      end = request.size ();
+
+    run_batch_query (writer, db, request.substr (start, end - start), format, totals);
+    start = end;
+  }
+
+  flush_writer (writer);
+  fclose       (out);
+
+  char header [64];
+  const int header_len = snprintf (header, sizeof (header), "%zu %zu %zu\n", bytes, totals.found, totals.not_found);
+
+  if (write_all (fd, header, (size_t)header_len))
+    write_all (fd, output, bytes);
+
+  free (output);
+}
+
+// Strips the line ending getline leaves on line
+std::string_view request_line (const char* line, ssize_t length)
+{
+  if (length != 0 && line [length - 1] == '\n')
+    --length;
+
+  return std::string_view (line, (size_t)length);
+}
+
+// Answers request lines until the client hangs up or goes quiet; false once the registry is stale
+bool serve_connection (int fd, const glv_db& db, const std::string& identity, const glv_source_stamp& loaded, const char* source_path)
+{
+  set_socket_timeouts (fd);
+
+  FILE*   in       = fdopen (fd, "r");
+  char*   line     = NULL;
+  size_t  capacity = 0;
+  ssize_t length;
+  bool    fresh    = true;
+
+  if (in == NULL) {
+    close (fd);
+    return true;
+  }
+
+  // A client of some other registry (or one that skips the handshake) is not answered from this one
+  if ((length = getline (&line, &capacity, in)) == -1 || request_line (line, length) != "registry " + identity) {
+    write_all (fd, "mismatch\n", 9);
+    length = -1;
+  }
+
+  while (length != -1 && (length = getline (&line, &capacity, in)) != -1) {
+    if (source_changed (loaded, source_path)) {
+      write_all (fd, "stale\n", 6);
+      fresh = false;
+      break;
+    }
+
+    serve_request (fd, db, request_line (line, length));
+  }
+
+  free   (line);
+  fclose (in);
+
+  return fresh;
+}
+
+std::string glv_serve_path;
+
+// Connections being served, and whether one of them found the registry stale
+struct glv_serve_state {
+  std::mutex              mutex;
+  std::condition_variable idle;
+  unsigned                connections;
+  bool                    stale;
+};
+
+void stop_serving (int)
+{
+  unlink (glv_serve_path.c_str ());
+  _exit  (0);
+}
+
+// glvs serve [-r registry.xml] [socket]
+int serve (const int argc, const char** argv)
+{
+  const char* registry_path = NULL;
+  const char* path_arg      = NULL;
+
+  for (int i = 2; i < argc; i++) {
+    if (((! strcmp (argv [i], "-r")) || (! strcmp (argv [i], "--registry"))) && i + 1 < argc)
+      registry_path = argv [++i];
+    else
+      path_arg = argv [i];
+  }
+
+  glv_serve_path = path_arg != NULL ? std::string (path_arg) : socket_path (registry_path);
+
+  glv_registry registry;
+  if (! open_registry (registry_path, registry, NULL)) {
+    printf (" @ ERROR: Cannot open '%s'\n", registry_path != NULL ? registry_path : "gl.xml");
+    return -2;
+  }
+
+  // Embedded tables cannot go stale; anything else is checked against the XML it came from
+  const char*            source_path = registry.info.source == GLV_DB_EMBEDDED ? NULL : registry_path != NULL ? registry_path : "gl.xml";
+  const glv_source_stamp loaded      = stamp_source (source_path);
+  const std::string      identity    = registry_identity (registry_path);
+
+  sockaddr_un address;
+  if (! socket_address (glv_serve_path, address)) {
+    printf (" @ ERROR: Socket path '%s' is too long\n", glv_serve_path.c_str ());
+    return -2;
+  }
+
+  const int running = connect_daemon (glv_serve_path);
+  if (running >= 0) {
+    close  (running);
+    printf (" @ ERROR: A daemon is already listening on '%s'\n", glv_serve_path.c_str ());
+    return -2;
+  }
+
+  // Nothing answered, so whatever is left at the path belongs to a daemon that did not exit cleanly
+  unlink (glv_serve_path.c_str ());
+
+  const int listener = socket (AF_UNIX, SOCK_STREAM, 0);
+  if (listener < 0 || bind (listener, (const sockaddr *)&address, sizeof (address)) != 0 || listen (listener, 64) != 0) {
+    printf (" @ ERROR: Cannot listen on '%s': %s\n", glv_serve_path.c_str (), strerror (errno));
+    return -2;
+  }
+
+  signal (SIGPIPE, SIG_IGN);
+  signal (SIGINT,  stop_serving);
+  signal (SIGTERM, stop_serving);
+
+  print_load_info (registry.info);
+  printf ("Serving on '%s'\n", glv_serve_path.c_str ());
+  fflush (stdout);
+
+  glv_serve_state state;
+  state.connections = 0;
+  state.stale       = false;
+
+  for (;;) {
+    const int fd = accept (listener, NULL, NULL);
+    if (fd < 0) {
+      if (errno == EINTR || errno == ECONNABORTED)
+        continue;
+      break;
+    }
+
+    {
+      std::lock_guard <std::mutex> lock (state.mutex);
+      if (state.stale) {
+        close (fd);
+        break;
+      }
+      ++state.connections;
+    }
+
+    // The first connection to find the registry stale wakes accept so the daemon can exit
+    std::thread ([fd, listener, &registry, &identity, &loaded, source_path, &state] () {
+      const bool fresh = serve_connection (fd, registry.db, identity, loaded, source_path);
+
+      std::lock_guard <std::mutex> lock (state.mutex);
+      if ((! fresh) && (! state.stale)) {
+        state.stale = true;
+        shutdown (listener, SHUT_RDWR);
+      }
+      --state.connections;
+      state.idle.notify_all ();
+    }).detach ();
+  }
+
+  close  (listener);
+  unlink (glv_serve_path.c_str ());
+
+  // Let connections already being served finish; an idle one is dropped after glv_daemon_timeout_s
+  {
+    std::unique_lock <std::mutex> lock (state.mutex);
+    state.idle.wait (lock, [&state] () { return state.connections == 0; });
+  }
+
+  if (state.stale)
+    printf ("Registry '%s' changed, exiting\n", source_path);
+
+  return 0;
+}
+
+enum glv_daemon_status {
+  GLV_DAEMON_ANSWERED,
+  GLV_DAEMON_UNAVAILABLE, // Nothing listening, a different registry, or it refused the request; answer locally
+  GLV_DAEMON_FAILED
+};
+
+// Sends the whole batch as one request and copies the response to stdout
+glv_daemon_status query_daemon (const std::string& path, const std::string& identity, const std::vector <std::string>& names,
+                                glv_format format, int& result)
+{
+  const int fd = connect_daemon (path);
+  if (fd < 0)
+    return GLV_DAEMON_UNAVAILABLE;
+
+  std::string request ("registry " + identity + "\n");
+  request += format == GLV_FORMAT_JSON ? "--json " : "";
+  for (size_t i = 0; i < names.size (); i++) {
+    request += names [i];
+    request += ' ';
+  }
+  request += '\n';
+
+  FILE* in = fdopen (fd, "r");
+  if (in == NULL || (! write_all (fd, request.data (), request.size ()))) {
+    if (in != NULL)
+      fclose (in);
+    else
+      close (fd);
+    return GLV_DAEMON_UNAVAILABLE;
+  }
+
+  shutdown (fd, SHUT_WR);
+
+  char             header [64];
+  size_t           bytes;
+  glv_batch_totals totals = glv_batch_totals ();
+
+  // No header in time (or at all, or "mismatch" or "stale") leaves the batch to answer locally; nothing has been written yet
+  if (fgets (header, sizeof (header), in) == NULL || sscanf (header, "%zu %zu %zu", &bytes, &totals.found, &totals.not_found) != 3) {
+    fclose (in);
+    return GLV_DAEMON_UNAVAILABLE;
+  }
+
+  char buffer [65536];
+  while (bytes != 0) {
+    const size_t chunk = fread (buffer, 1, std::min (bytes, sizeof (buffer)), in);
+    if (chunk == 0)
+      break;
+    fwrite (buffer, 1, chunk, stdout);
+    bytes -= chunk;
+  }
+
+  fclose (in);
+
+  if (bytes != 0) {
+    fflush  (stdout);
+    fprintf (stderr, " @ ERROR: Daemon on '%s' hung up mid-response\n", path.c_str ());
+    return GLV_DAEMON_FAILED;
+  }
+
+  result = finish_batch (totals);
+
+  return GLV_DAEMON_ANSWERED;
+}
+
+// Answers the batch through a running daemon if there is one; false to answer it locally. Names are read
+//   up front so that a daemon that turns out to be stale still leaves them to answer locally.
+bool run_remote_batch (const char* registry_path, std::vector <glv_input>& inputs, std::vector <std::string>& names, glv_format format, int& result)
+{
+  const std::string path = socket_path (registry_path);
+
+  if (access (path.c_str (), F_OK) != 0)
+    return false;
+
+  if (! for_each_input_name (inputs, [&names] (std::string_view name) { names.push_back (std::string (name)); })) {
+    result = -2;
+    return true;
+  }
+
+  switch (query_daemon (path, registry_identity (registry_path), names, format, result)) {
+    case GLV_DAEMON_ANSWERED:
+      return true;
+    case GLV_DAEMON_FAILED:
+      result = -2;
+      return true;
+    case GLV_DAEMON_UNAVAILABLE:
+      break;
+  }
+
+  // Lists have been consumed; answer from the names already read
+  inputs.clear ();
+  for (size_t i = 0; i < names.size (); i++) {
+    glv_input input = { names [i].c_str (), false };
+    inputs.push_back (input);
+  }
+
+  return false;
+}
 #endif
 
-using namespace rapidxml;
 
-xml_node<>* glv_registry;
-xml_node<>* glv_extensions;
-xml_node<>* glv_commands;
-xml_node<>* glv_features;
-xml_node<>* glv_enums;
+//
+// Registry diff
+//
+//   'glvs diff old.xml new.xml' lists what an update changed, one line per change, e.g.
+//     "+ enum      GL_FOO 0x9630" or "~ command   glFoo void glFoo (GLint x) -> void glFoo (GLuint x)".
+//     Both registries load at once, and each name is looked up in the other through its perfect hash,
+//     so a diff takes time linear in the size of the two.
+//
+struct glv_diff_totals {
+  uint32_t added;
+  uint32_t removed;
+  uint32_t changed;
+};
+
+void print_diff (FILE* out, glv_diff_totals& totals, char change, const char* kind, std::string_view name, const std::string& detail)
+{
+  fprintf (out, "%c %-9s %.*s%s%s\n", change, kind, GLV_FMT_STR (name), detail.empty () ? "" : " ", detail.c_str ());
+
+  switch (change) {
+    case '+': ++totals.added;   break;
+    case '-': ++totals.removed; break;
+    default:  ++totals.changed; break;
+  }
+}
+
+// "require GL_VERSION_3_0, remove GL_VERSION_3_2 [core]", or "none"
+std::string format_lifecycle (const glv_db& db, glv_id name)
+{
+  const glv_table <glv_action_rec> actions = find_actions (db, name);
+
+  std::string lifecycle;
+  for (uint32_t i = 0; i < actions.count; i++) {
+    if (i != 0)
+      lifecycle += ", ";
+    lifecycle += glv_verb_names [actions [i].verb];
+    lifecycle += ' ';
+    lifecycle += db.name (db.features [actions [i].feature].name);
+    if (actions [i].profile.length != 0)
+      lifecycle += " [" + std::string (db.str (actions [i].profile)) + "]";
+  }
+
+  return lifecycle.empty () ? "none" : lifecycle;
+}
+
+std::string format_enum_value (const glv_enum_rec& enum_entry)
+{
+  char text [32];
+  snprintf (text, sizeof (text), "0x%04llX", (unsigned long long)enum_entry.value);
+  return text;
+}
+
+bool is_core (const glv_db& db, glv_id name)
+{
+  const glv_table <glv_action_rec> actions = find_actions (db, name);
+  return actions.count != 0 && actions [0].verb == GLV_REQUIRE;
+}
+
+// Every <enum> of each name in registry order; names.enum_id only keeps the first, and some names have one per API
+typedef std::vector <std::vector <glv_id> > glv_enum_definitions;
+
+glv_enum_definitions find_enum_definitions (const glv_db& db)
+{
+  glv_enum_definitions definitions (db.names.count);
+  for (glv_id i = 0; i < db.enums.count; i++)
+    definitions [db.enums [i].name].push_back (i);
+
+  return definitions;
+}
+
+// The definition of the same API, GLV_NONE if there is none
+glv_id find_enum_definition (const glv_db& db, const std::vector <glv_id>& definitions, std::string_view api)
+{
+  for (size_t i = 0; i < definitions.size (); i++) {
+    if (db.str (db.enums [definitions [i]].api) == api)
+      return definitions [i];
+  }
+
+  return GLV_NONE;
+}
+
+// " [gles2]" for an API specific definition
+std::string format_enum_api (const glv_db& db, const glv_enum_rec& enum_entry)
+{
+  return enum_entry.api.length != 0 ? " [" + std::string (db.str (enum_entry.api)) + "]" : std::string ();
+}
+
+std::string alias_target (const glv_db& db, glv_id alias)
+{
+  return alias != GLV_NONE ? std::string (db.name (alias)) : std::string ();
+}
+
+void diff_alias (FILE* out, glv_diff_totals& totals, std::string_view name, const std::string& old_target, const std::string& target,
+                 const std::string& suffix)
+{
+  if (old_target == target)
+    return;
+
+  if (old_target.empty ())
+    print_diff (out, totals, '+', "alias", name, "-> " + target + suffix);
+  else if (target.empty ())
+    print_diff (out, totals, '-', "alias", name, "-> " + old_target + suffix);
+  else
+    print_diff (out, totals, '~', "alias", name, old_target + " -> " + target + suffix);
+}
+
+// Everything new, or changed since, about one name of to
+void diff_name (FILE* out, const glv_db& from, const glv_db& to, const glv_enum_definitions& from_enums, const glv_enum_definitions& to_enums,
+                glv_id name, glv_diff_totals& totals)
+{
+  const std::string_view text   = to.name (name);
+  const glv_name_rec&    record = to.names [name];
+  const glv_id           old    = find_name (from, text);
+  const glv_name_rec*    before = old != GLV_NONE ? &from.names [old] : NULL;
+
+  if (record.feature != GLV_NONE && (before == NULL || before->feature == GLV_NONE)) {
+    const glv_feature_rec& feature = to.features [record.feature];
+    print_diff (out, totals, '+', "feature", text, std::string (to.str (feature.api)) + " " + std::string (to.str (feature.number)));
+  }
+
+  if (record.extension != GLV_NONE) {
+    const uint32_t supported = to.extensions [record.extension].supported;
+    if (before == NULL || before->extension == GLV_NONE)
+      print_diff (out, totals, '+', "extension", text, format_api_mask (supported));
+    else if (from.extensions [before->extension].supported != supported)
+      print_diff (out, totals, '~', "extension", text, format_api_mask (from.extensions [before->extension].supported) + " -> " + format_api_mask (supported));
+  }
+
+  if (record.command != GLV_NONE) {
+    const std::string signature = format_signature (to, record.command);
+    if (before == NULL || before->command == GLV_NONE) {
+      print_diff (out, totals, '+', "command", text, signature);
+    } else {
+      const std::string old_signature = format_signature (from, before->command);
+      if (old_signature != signature)
+        print_diff (out, totals, '~', "command", text, old_signature + " -> " + signature);
+    }
+
+    const glv_id old_alias = before != NULL && before->command != GLV_NONE ? from.commands [before->command].alias : GLV_NONE;
+    diff_alias (out, totals, text, alias_target (from, old_alias), alias_target (to, to.commands [record.command].alias), std::string ());
+  }
+
+  // Each definition against the old one for the same API
+  const std::vector <glv_id>& definitions = to_enums [name];
+  for (size_t i = 0; i < definitions.size (); i++) {
+    const glv_enum_rec& enum_entry = to.enums [definitions [i]];
+    const std::string   api        = format_enum_api   (to, enum_entry);
+    const std::string   value      = format_enum_value (enum_entry);
+    const glv_id        old_id     = old != GLV_NONE ? find_enum_definition (from, from_enums [old], to.str (enum_entry.api)) : GLV_NONE;
+
+    if (old_id == GLV_NONE) {
+      print_diff (out, totals, '+', "enum", text, value + api);
+    } else {
+      const std::string old_value = format_enum_value (from.enums [old_id]);
+      if (old_value != value)
+        print_diff (out, totals, '~', "enum", text, old_value + " -> " + value + api);
+    }
+
+    diff_alias (out, totals, text, alias_target (from, old_id != GLV_NONE ? from.enums [old_id].alias : GLV_NONE), alias_target (to, enum_entry.alias), api);
+  }
+
+  // Lifecycles only compare for names both registries define; a new name's lifecycle is part of it being new
+  const bool defined_before = before != NULL && (before->command != GLV_NONE || before->enum_id != GLV_NONE);
+  if ((record.command != GLV_NONE || record.enum_id != GLV_NONE) && defined_before) {
+    const std::string lifecycle     = format_lifecycle (to,   name);
+    const std::string old_lifecycle = format_lifecycle (from, old);
+
+    if (is_core (to, name) && (! is_core (from, old)))
+      print_diff (out, totals, '+', "core", text, lifecycle);
+    else if (lifecycle != old_lifecycle)
+      print_diff (out, totals, '~', "lifecycle", text, old_lifecycle + " -> " + lifecycle);
+  }
+}
+
+// Whatever of one name of from is gone from to
+void diff_removed_name (FILE* out, const glv_db& from, const glv_db& to, const glv_enum_definitions& from_enums,
+                        const glv_enum_definitions& to_enums, glv_id name, glv_diff_totals& totals)
+{
+  const std::string_view text   = from.name (name);
+  const glv_name_rec&    record = from.names [name];
+  const glv_id           now    = find_name (to, text);
+  const glv_name_rec*    after  = now != GLV_NONE ? &to.names [now] : NULL;
+
+  if (record.feature != GLV_NONE && (after == NULL || after->feature == GLV_NONE))
+    print_diff (out, totals, '-', "feature", text, std::string ());
+  if (record.extension != GLV_NONE && (after == NULL || after->extension == GLV_NONE))
+    print_diff (out, totals, '-', "extension", text, std::string ());
+  if (record.command != GLV_NONE && (after == NULL || after->command == GLV_NONE))
+    print_diff (out, totals, '-', "command", text, format_signature (from, record.command));
+
+  const std::vector <glv_id>& definitions = from_enums [name];
+  for (size_t i = 0; i < definitions.size (); i++) {
+    const glv_enum_rec& enum_entry = from.enums [definitions [i]];
+    if (now == GLV_NONE || find_enum_definition (to, to_enums [now], from.str (enum_entry.api)) == GLV_NONE)
+      print_diff (out, totals, '-', "enum", text, format_enum_value (enum_entry) + format_enum_api (from, enum_entry));
+  }
+}
+
+// glvs diff old.xml new.xml; exits 0 when nothing changed and 1 when something did
+int diff_registries (const int argc, const char** argv)
+{
+  if (argc != 4) {
+    printf (" @ ERROR: 'glvs diff' needs two registries, the old one first\n");
+    return -2;
+  }
+
+  glv_registry from, to;
+  bool         from_opened = false;
+
+  std::thread loader ([&] { from_opened = open_registry (argv [2], from, NULL); });
+  const bool  to_opened = open_registry (argv [3], to, NULL);
+  loader.join ();
+
+  if (! (from_opened && to_opened)) {
+    printf (" @ ERROR: Cannot open '%s'\n", from_opened ? argv [3] : argv [2]);
+    return -2;
+  }
+
+  printf ("--- %s\n"
+          "+++ %s\n", argv [2], argv [3]);
+
+  glv_diff_totals            totals     = { 0, 0, 0 };
+  const glv_enum_definitions from_enums = find_enum_definitions (from.db);
+  const glv_enum_definitions to_enums   = find_enum_definitions (to.db);
+
+  for (glv_id name = 0; name < to.db.names.count; name++)
+    diff_name (stdout, from.db, to.db, from_enums, to_enums, name, totals);
+
+  for (glv_id name = 0; name < from.db.names.count; name++)
+    diff_removed_name (stdout, from.db, to.db, from_enums, to_enums, name, totals);
+
+  printf ("%u added, %u removed, %u changed\n", totals.added, totals.removed, totals.changed);
+
+  return totals.added + totals.removed + totals.changed != 0 ? 1 : 0;
+}
+
+
+//
+// Loader generation
+//
+//   'glvs header gl:4.5:core GL_ARB_bindless_texture -o gl45' writes gl45.h, with the types, enums and
+//     function pointer typedefs of that selection, and gl45.c, which fills a dispatch table from any
+//     GetProcAddress. Everything comes from the indexed tables; gl.xml is not walked again.
+//
+struct glv_loader {
+  std::string            api;
+  std::string            profile;
+  double                 version;
+  std::string            stem;        // C identifier the table, its type and the load function are named after
+  std::vector <glv_id>   extensions;  // Extension ids, as asked for
+  std::vector <uint64_t> names;       // Bitset over name ids
+  std::vector <glv_id>   commands;    // Command ids, in registry order
+  std::vector <glv_id>   type_of;     // Per name id, the type record that applies to api
+  std::vector <glv_id>   enum_of;     // Per name id, the enum record that applies to api
+};
+
+bool has_name (const glv_loader& loader, glv_id name)
+{
+  return (loader.names [name / 64] >> (name % 64)) & 1;
+}
+
+// API specific definitions replace generic ones, whichever comes first
+void select_api_records (const glv_db& db, const glv_loader& loader, std::vector <glv_id>& type_of, std::vector <glv_id>& enum_of)
+{
+  type_of.assign (db.names.count, GLV_NONE);
+  enum_of.assign (db.names.count, GLV_NONE);
+
+  for (glv_id i = 0; i < db.types.count; i++) {
+    const std::string_view api = db.str (db.types [i].api);
+    if (api == loader.api || (api.empty () && type_of [db.types [i].name] == GLV_NONE))
+      type_of [db.types [i].name] = i;
+  }
+
+  for (glv_id i = 0; i < db.enums.count; i++) {
+    const std::string_view api = db.str (db.enums [i].api);
+    if (api == loader.api || (api.empty () && enum_of [db.enums [i].name] == GLV_NONE))
+      enum_of [db.enums [i].name] = i;
+  }
+}
+
+// Every name the version makes available, plus whatever the extensions provide on api
+void select_loader_names (const glv_db& db, glv_loader& loader)
+{
+  find_available (db, loader.api, loader.version, loader.profile, loader.names);
+
+  if (! loader.extensions.empty ()) {
+    const unsigned int api_mask = parse_api_mask (loader.api);
+    std::vector <bool> wanted (db.extensions.count, false);
+    for (size_t i = 0; i < loader.extensions.size (); i++)
+      wanted [loader.extensions [i]] = true;
+
+    for (glv_id name = 0; name < db.names.count; name++) {
+      const glv_table <glv_provider_rec> providers = find_ext_reqs (db, name);
+      for (uint32_t i = 0; i < providers.count; i++) {
+        if (wanted [providers [i].extension] && (providers [i].apis & api_mask))
+          loader.names [name / 64] |= (uint64_t)1 << (name % 64);
+      }
+    }
+  }
+
+  for (glv_id i = 0; i < db.commands.count; i++) {
+    if (has_name (loader, db.commands [i].name))
+      loader.commands.push_back (i);
+  }
+
+  select_api_records (db, loader, loader.type_of, loader.enum_of);
+}
+
+void write_loader_type (FILE* out, const glv_db& db, const glv_loader& loader, glv_id type, std::vector <bool>& written)
+{
+  if (written [type])
+    return;
+  written [type] = true;
+
+  const glv_id required_type = db.types [type].required_type;
+  if (required_type != GLV_NONE && loader.type_of [required_type] != GLV_NONE)
+    write_loader_type (out, db, loader, loader.type_of [required_type], written);
+
+  fprintf (out, "%.*s\n", GLV_FMT_STR (db.str (db.types [type].text)));
+}
+
+// In registry order, each after the type it requires; only types a selected name or command uses
+void write_loader_types (FILE* out, const glv_db& db, const glv_loader& loader)
+{
+  std::vector <bool> used (db.names.count, false);
+  for (glv_id name = 0; name < db.names.count; name++)
+    used [name] = has_name (loader, name) && loader.type_of [name] != GLV_NONE;
+
+  for (size_t i = 0; i < loader.commands.size (); i++) {
+    const glv_command_rec& command = db.commands [loader.commands [i]];
+    const glv_id           ret     = find_name (db, db.str (command.ptype));
+    if (ret != GLV_NONE)
+      used [ret] = true;
+
+    for (uint32_t j = 0; j < command.num_params; j++) {
+      const glv_id ptype = find_name (db, db.str (db.params [command.first_param + j].ptype));
+      if (ptype != GLV_NONE)
+        used [ptype] = true;
+    }
+  }
+
+  std::vector <bool> written (db.types.count, false);
+  for (glv_id i = 0; i < db.types.count; i++) {
+    if (used [db.types [i].name] && loader.type_of [db.types [i].name] == i)
+      write_loader_type (out, db, loader, i, written);
+  }
+}
+
+// The value as gl.xml would spell it: hex, negative decimal, or a 64-bit ull constant
+void write_loader_enum (FILE* out, const glv_db& db, const glv_enum_rec& enum_entry)
+{
+  const std::string_view name  = db.name (enum_entry.name);
+  const uint64_t         value = enum_entry.value;
+
+  if (enum_entry.flags & GLV_ENUM_ULL)
+    fprintf (out, "#define %-56.*s 0x%016llXull\n", GLV_FMT_STR (name), (unsigned long long)value);
+  else if ((long long)value < 0)
+    fprintf (out, "#define %-56.*s %lld\n", GLV_FMT_STR (name), (long long)value);
+  else
+    fprintf (out, "#define %-56.*s 0x%04llX\n", GLV_FMT_STR (name), (unsigned long long)value);
+}
+
+// glCullFace -> PFNGLCULLFACEPROC
+std::string loader_proc_type (std::string_view name)
+{
+  std::string type ("PFN");
+  for (size_t i = 0; i < name.size (); i++)
+    type += (char)toupper ((uint8_t)name [i]);
+
+  return type + "PROC";
+}
+
+bool write_loader_header (const char* path, const char* registry_path, const glv_db& db, const glv_loader& loader)
+{
+  FILE* out = fopen (path, "wb");
+  if (out == NULL)
+    return false;
+
+  std::string guard;
+  for (size_t i = 0; i < loader.stem.size (); i++)
+    guard += (char)toupper ((uint8_t)loader.stem [i]);
+  guard += "_H";
+
+  fprintf (out, "// Generated by 'glvs header' from %s: %s %.1f%s%s, %zu extension%s; do not edit.\n\n",
+                registry_path, loader.api.c_str (), loader.version, loader.profile.empty () ? "" : " ", loader.profile.c_str (),
+                loader.extensions.size (), loader.extensions.size () != 1 ? "s" : "");
+
+  fprintf (out, "#ifndef %s\n"
+                "#define %s\n\n"
+                "#ifndef APIENTRY\n"
+                "# if defined (_WIN32)\n"
+                "#  define APIENTRY __stdcall\n"
+                "# else\n"
+                "#  define APIENTRY\n"
+                "# endif\n"
+                "#endif\n"
+                "#ifndef APIENTRYP\n"
+                "# define APIENTRYP APIENTRY *\n"
+                "#endif\n\n"
+                "#ifdef __cplusplus\n"
+                "extern \"C\" {\n"
+                "#endif\n\n", guard.c_str (), guard.c_str ());
+
+  write_loader_types (out, db, loader);
+
+  fprintf (out, "\n");
+
+  for (glv_id i = 0; i < db.features.count; i++) {
+    const glv_feature_rec& feature = db.features [i];
+    if (db.str (feature.api) == loader.api && parse_version (db.str (feature.number)) <= loader.version)
+      fprintf (out, "#define %.*s 1\n", GLV_FMT_STR (db.name (feature.name)));
+  }
+
+  for (size_t i = 0; i < loader.extensions.size (); i++)
+    fprintf (out, "#define %.*s 1\n", GLV_FMT_STR (db.name (db.extensions [loader.extensions [i]].name)));
+
+  fprintf (out, "\n");
+
+  // In registry order, each name once
+  for (glv_id i = 0; i < db.enums.count; i++) {
+    const glv_id name = db.enums [i].name;
+    if (has_name (loader, name) && loader.enum_of [name] == i)
+      write_loader_enum (out, db, db.enums [i]);
+  }
+
+  fprintf (out, "\n");
+
+  for (size_t i = 0; i < loader.commands.size (); i++) {
+    const glv_command_rec& command = db.commands [loader.commands [i]];
+
+    fprintf (out, "typedef %.*s(APIENTRYP %s) (", GLV_FMT_STR (db.str (command.proto)), loader_proc_type (db.name (command.name)).c_str ());
+    for (uint32_t j = 0; j < command.num_params; j++) {
+      const glv_param_rec& param = db.params [command.first_param + j];
+      fprintf (out, "%s%.*s%.*s", j != 0 ? ", " : "", GLV_FMT_STR (db.str (param.type)), GLV_FMT_STR (db.str (param.name)));
+    }
+    fprintf (out, "%s);\n", command.num_params == 0 ? "void" : "");
+  }
+
+  fprintf (out, "\nstruct %s_dispatch {\n", loader.stem.c_str ());
+  for (size_t i = 0; i < loader.commands.size (); i++) {
+    const std::string_view name = db.name (db.commands [loader.commands [i]].name);
+    fprintf (out, "  %-48s %.*s;\n", loader_proc_type (name).c_str (), GLV_FMT_STR (name));
+  }
+  fprintf (out, "};\n\n");
+
+  const char* stem = loader.stem.c_str ();
+
+  // A generic function pointer, like eglGetProcAddress and glXGetProcAddress return, converts to any other
+  fprintf (out, "extern struct %s_dispatch %s_dispatch;\n\n"
+                "// Fills %s_dispatch through get_proc; returns how many of its %zu entries were found\n"
+                "typedef void (*%s_proc) (void);\n"
+                "typedef %s_proc (*%s_get_proc) (const char* name);\n"
+                "int %s_load (%s_get_proc get_proc);\n\n",
+                stem, stem, stem, loader.commands.size (), stem, stem, stem, stem, stem);
+
+  // Calls by name go through the table; the loader itself needs the bare member names
+  fprintf (out, "#ifndef %s_DISPATCH_ONLY\n", guard.substr (0, guard.size () - 2).c_str ());
+  for (size_t i = 0; i < loader.commands.size (); i++) {
+    const std::string_view name = db.name (db.commands [loader.commands [i]].name);
+    fprintf (out, "#define %-48.*s %s_dispatch.%.*s\n", GLV_FMT_STR (name), stem, GLV_FMT_STR (name));
+  }
+  fprintf (out, "#endif\n");
+
+  fprintf (out, "\n"
+                "#ifdef __cplusplus\n"
+                "}\n"
+                "#endif\n\n"
+                "#endif // %s\n", guard.c_str ());
+
+  return fclose (out) == 0;
+}
+
+bool write_loader_source (const char* path, const char* header_path, const glv_db& db, const glv_loader& loader)
+{
+  FILE* out = fopen (path, "wb");
+  if (out == NULL)
+    return false;
+
+  const char* header_name = header_path + std::string (header_path).find_last_of ("/\\") + 1;
+
+  std::string dispatch_only;
+  for (size_t i = 0; i < loader.stem.size (); i++)
+    dispatch_only += (char)toupper ((uint8_t)loader.stem [i]);
+
+  fprintf (out, "// Generated by 'glvs header'; do not edit.\n\n"
+                "#define %s_DISPATCH_ONLY\n"
+                "#include \"%s\"\n\n"
+                "#include <stddef.h>\n\n"
+                "struct %s_dispatch %s_dispatch;\n\n"
+                "int %s_load (%s_get_proc get_proc)\n"
+                "{\n"
+                "  int loaded = 0;\n\n",
+                dispatch_only.c_str (), header_name, loader.stem.c_str (), loader.stem.c_str (), loader.stem.c_str (), loader.stem.c_str ());
+
+  // Each entry is assigned through its own type, so the table never has to be treated as an array
+  for (size_t i = 0; i < loader.commands.size (); i++) {
+    const std::string_view name = db.name (db.commands [loader.commands [i]].name);
+    fprintf (out, "  loaded += (%s_dispatch.%.*s = (%s)get_proc (\"%.*s\")) != NULL;\n", loader.stem.c_str (), GLV_FMT_STR (name),
+                  loader_proc_type (name).c_str (), GLV_FMT_STR (name));
+  }
+
+  fprintf (out, "\n"
+                "  return loaded;\n"
+                "}\n");
+
+  return fclose (out) == 0;
+}
+
+// glvs header [-r registry.xml] [-o NAME] API:VERSION[:PROFILE] [EXTENSION...]
+int generate_loader (const int argc, const char** argv)
+{
+  const char* registry_path = NULL;
+  const char* out_name      = NULL;
+  const char* selection     = NULL;
+  std::vector <const char*> extension_names;
+
+  for (int i = 2; i < argc; i++) {
+    if ((! strcmp (argv [i], "-r")) && i + 1 < argc) {
+      registry_path = argv [++i];
+    } else if ((! strcmp (argv [i], "-o")) && i + 1 < argc) {
+      out_name = argv [++i];
+    } else if (argv [i][0] == '-') {
+      printf (" @ ERROR: Unknown option '%s'\n", argv [i]);
+      return -2;
+    } else if (selection == NULL) {
+      selection = argv [i];
+    } else {
+      extension_names.push_back (argv [i]);
+    }
+  }
+
+  glv_loader       loader;
+  std::string_view api, profile;
+  if (selection == NULL || (! is_available_query (selection, api, loader.version, profile))) {
+    printf (" @ ERROR: 'glvs header' needs an API:VERSION[:PROFILE] such as gl:4.5:core\n");
+    return -2;
+  }
+  loader.api     = std::string (api);
+  loader.profile = std::string (profile);
+
+  glv_registry registry;
+  if (! open_registry (registry_path, registry, NULL)) {
+    printf (" @ ERROR: Cannot open '%s'\n", registry_path != NULL ? registry_path : "gl.xml");
+    return -2;
+  }
+
+  const glv_db& db = registry.db;
+
+  if (! is_known_profile (db, profile)) {
+    printf (" @ ERROR: No feature names a '%.*s' profile\n", GLV_FMT_STR (profile));
+    return -2;
+  }
+
+  for (size_t i = 0; i < extension_names.size (); i++) {
+    const glv_id name = find_name (db, extension_names [i]);
+    if (name == GLV_NONE || db.names [name].extension == GLV_NONE) {
+      printf (" @ ERROR: '%s' is not an extension\n", extension_names [i]);
+      return -2;
+    }
+    if (! (db.extensions [db.names [name].extension].supported & parse_api_mask (api))) {
+      printf (" @ ERROR: '%s' is not supported on %.*s\n", extension_names [i], GLV_FMT_STR (api));
+      return -2;
+    }
+    loader.extensions.push_back (db.names [name].extension);
+  }
+
+  const auto start = std::chrono::steady_clock::now ();
+
+  select_loader_names (db, loader);
+  if (loader.commands.empty ()) {
+    printf (" @ ERROR: There is no %.*s feature up to version %.1f\n", GLV_FMT_STR (api), loader.version);
+    return -2;
+  }
+
+  // "out/gl45.h" writes out/gl45.h and out/gl45.c, with a table named gl45_dispatch
+  const std::string base  = replace_extension (out_name != NULL ? out_name : ("glvs_" + loader.api).c_str (), "");
+  const size_t      slash = base.find_last_of ("/\\");
+  for (size_t i = slash == std::string::npos ? 0 : slash + 1; i < base.size (); i++)
+    loader.stem += isalnum ((uint8_t)base [i]) ? base [i] : '_';
+  if (loader.stem.empty () || isdigit ((uint8_t)loader.stem [0]))
+    loader.stem.insert (0, "glvs_");
+
+  const std::string header_path = base + ".h";
+  const std::string source_path = base + ".c";
+  const char*       source_xml  = registry_path != NULL ? registry_path : "gl.xml";
+
+  if (! write_loader_header (header_path.c_str (), source_xml, db, loader)) {
+    printf (" @ ERROR: Cannot write '%s'\n", header_path.c_str ());
+    return -2;
+  }
+  if (! write_loader_source (source_path.c_str (), header_path.c_str (), db, loader)) {
+    printf (" @ ERROR: Cannot write '%s'\n", source_path.c_str ());
+    return -2;
+  }
+
+  printf ("Generated '%s' and '%s': %zu commands in %.2f ms\n", header_path.c_str (), source_path.c_str (),
+            loader.commands.size (), elapsed_ms (start));
+
+  return 0;
+}
 
-xml_node<>* find_enum (const char* name)
+
+//
+// Benchmarks
+//
+//   'glvs bench' times every lookup two ways over the whole registry: by walking the parsed document the
+//     way glvs originally did (find_command, find_action and find_next_action, find_ext_req, ...), and
+//     through the indexed tables that replaced those walks. Every command and enum name is looked up,
+//     plus as many names that are not in the registry.
+//
+// Linear searches of the document, as they were before the tables existed
+xml_node<>* dom_find_command (xml_node<>* registry, std::string_view name)
 {
-  xml_node<>* enum_group = glv_enums;
-  while (enum_group != NULL) {
-    xml_node<>* enum_entry = enum_group->first_node ("enum");
-    while (enum_entry != NULL) {
-      if (! strcmp (enum_entry->first_attribute ("name")->value (), name)) {
-        return enum_entry;
-      }
-      enum_entry = enum_entry->next_sibling ("enum");
+  for (xml_node<>* commands = registry->first_node ("commands"); commands != NULL; commands = commands->next_sibling ("commands")) {
+    for (xml_node<>* command = commands->first_node ("command"); command != NULL; command = command->next_sibling ("command")) {
+      if (xml_value (command->first_node ("proto")->first_node ("name")) == name)
+        return command;
     }
-    enum_group = enum_group->next_sibling ("enums");
   }
 
   return NULL;
 }
 
-// Finds enum aliases by cross-referencing their value (does not use the alias XML attribute)
-xml_node<>* find_next_enum (xml_node<>* enum_node)
+xml_node<>* dom_find_enum (xml_node<>* registry, std::string_view name)
 {
-  xml_node<>* enum_entry = enum_node->next_sibling ("enum");
-  while (enum_entry != NULL) {
-    // Case insensitive since we are really comparing hexadecimal numbers (e.g. 0xF00D vs 0xf00d) and not strings
-    if (! stricmp (enum_entry->first_attribute ("value")->value (), enum_node->first_attribute ("value")->value ())) {
-      return enum_entry;
+  for (xml_node<>* enum_group = registry->first_node ("enums"); enum_group != NULL; enum_group = enum_group->next_sibling ("enums")) {
+    for (xml_node<>* enum_entry = enum_group->first_node ("enum"); enum_entry != NULL; enum_entry = enum_entry->next_sibling ("enum")) {
+      if (xml_attribute_value (enum_entry, "name") == name)
+        return enum_entry;
     }
-    enum_entry = enum_entry->next_sibling ("enum");
   }
 
   return NULL;
 }
 
-xml_node<>* find_action (const char* name, const char* verb) {
-  xml_node<>* feature = glv_features;
+// Enums after enum_node in its block with the same value text
+xml_node<>* dom_find_next_enum (xml_node<>* enum_node)
+{
+  const std::string_view value = xml_attribute_value (enum_node, "value");
 
-  while (feature != NULL) {
-    xml_node<>* action = feature->first_node (verb);
-    while (action != NULL) {
-      xml_node<>* entry = action->first_node ();
-      while (entry != NULL) {
-        if (! strcmp (entry->first_attribute ("name")->value (), name)) {
-          return entry->parent ()->parent ();
-        }
-        entry = entry->next_sibling ();
-      }
-      action = action->next_sibling (verb);
-    }
-    feature = feature->next_sibling ("feature");
+  for (xml_node<>* enum_entry = enum_node->next_sibling ("enum"); enum_entry != NULL; enum_entry = enum_entry->next_sibling ("enum")) {
+    // Case insensitive, since these are hex numbers (0xF00D vs 0xf00d) rather than strings
+    const std::string_view other = xml_attribute_value (enum_entry, "value");
+    bool                   same  = other.size () == value.size ();
+    for (size_t i = 0; i < value.size () && same; i++)
+      same = tolower ((uint8_t)other [i]) == tolower ((uint8_t)value [i]);
+    if (same)
+      return enum_entry;
   }
 
   return NULL;
 }
 
-xml_node<>* find_next_action (const char* name, xml_node<>* feature, const char* verb) {
-  feature = feature->next_sibling ("feature");
-
-  while (feature != NULL) {
-    xml_node<>* action = feature->first_node (verb);
-    while (action != NULL) {
-      xml_node<>* entry = action->first_node ();
-      while (entry != NULL) {
-        if (! strcmp (entry->first_attribute ("name")->value (), name)) {
-          return entry->parent ()->parent ();
-        }
-        entry = entry->next_sibling ();
+// The next feature from feature on (inclusive) with a verb block listing name
+xml_node<>* dom_find_action (xml_node<>* feature, std::string_view name, const char* verb)
+{
+  for (; feature != NULL; feature = feature->next_sibling ("feature")) {
+    for (xml_node<>* action = feature->first_node (verb); action != NULL; action = action->next_sibling (verb)) {
+      for (xml_node<>* entry = action->first_node (); entry != NULL; entry = entry->next_sibling ()) {
+        if (xml_attribute_value (entry, "name") == name)
+          return feature;
       }
-      action = action->next_sibling (verb);
     }
-    feature = feature->next_sibling ("feature");
   }
 
   return NULL;
 }
 
+xml_node<>* dom_find_ext_req (xml_node<>* registry, std::string_view name)
+{
+  xml_node<>* extensions = registry->first_node ("extensions");
 
-// TODO: Multiple extensions may fit the bill
-xml_node<>* find_ext_req (const char* name) {
-  xml_node<>* extension = glv_extensions->first_node ("extension");
-
-  while (extension != NULL) {
-    xml_node<>* require = extension->first_node ("require");
-    while (require != NULL) {
-      xml_node<>* entry = require->first_node ();
-      while (entry != NULL) {
-        if (! strcmp (entry->first_attribute ("name")->value (), name)) {
-          return entry->parent ()->parent ();
-        }
-        entry = entry->next_sibling ();
+  for (xml_node<>* extension = extensions->first_node ("extension"); extension != NULL; extension = extension->next_sibling ("extension")) {
+    for (xml_node<>* require = extension->first_node ("require"); require != NULL; require = require->next_sibling ("require")) {
+      for (xml_node<>* entry = require->first_node (); entry != NULL; entry = entry->next_sibling ()) {
+        if (xml_attribute_value (entry, "name") == name)
+          return extension;
       }
-      require = require->next_sibling ("require");
     }
-    extension = extension->next_sibling ("extension");
   }
 
   return NULL;
 }
 
-
-// TODO: Add support for reverse command aliasing
-xml_node<>* find_command(const char* name)
+// The next command after current whose <alias> names command_name
+xml_node<>* dom_find_next_command_alias (xml_node<>* current, std::string_view command_name)
 {
-  xml_node<>* command = glv_commands->first_node ("command");
-
-  while (command != NULL) {
-    xml_node<>* command_name = command->first_node ("proto")->first_node ("name");
-    if (! strcmp (command_name->value (), name))
+  for (xml_node<>* command = current->next_sibling ("command"); command != NULL; command = command->next_sibling ("command")) {
+    xml_node<>* alias = command->first_node ("alias");
+    if (alias != NULL && xml_attribute_value (alias, "name") == command_name)
       return command;
-    command = command->next_sibling ("command");
   }
 
   return NULL;
 }
 
-// Finds command aliases using the actual `alias` node in the XML registry
-xml_node<>* find_next_command_alias (xml_node<>* command_node, xml_node<>* current)
+// Keeps the compiler from discarding lookups whose results are otherwise unused
+volatile uintptr_t glv_bench_sink;
+
+// Times fn on each name, repeating it reps times per name so that fast lookups are not lost in the
+//   resolution of the clock, and prints the per-call latency distribution
+template <typename Fn>
+void run_bench (const char* operation, const char* path, const std::vector <std::string>& names, uint32_t reps, Fn fn)
 {
-  xml_node<>* command = current->next_sibling ("command");
-  while (command != NULL) {
-    xml_node<>* alias = command->first_node ("alias");
-    if (alias != NULL) {
-      if (! strcmp (alias->first_attribute ("name")->value (), command_node->first_node ("proto")->first_node ("name")->value ())) {
-        return command;
-      }
-    }
-    command = command->next_sibling ("command");
+  if (names.empty ())
+    return;
+
+  std::vector <double> ns (names.size ());
+  uintptr_t            sink = 0;
+
+  for (size_t i = 0; i < names.size (); i++) {
+    const std::string_view name  = names [i];
+    const auto             start = std::chrono::steady_clock::now ();
+    for (uint32_t r = 0; r < reps; r++)
+      sink += fn (name);
+    ns [i] = std::chrono::duration <double, std::nano> (std::chrono::steady_clock::now () - start).count () / reps;
   }
 
-  return NULL;
+  glv_bench_sink = sink;
+
+  double total = 0.0;
+  for (size_t i = 0; i < ns.size (); i++)
+    total += ns [i];
+
+  std::sort (ns.begin (), ns.end ());
+
+  printf ("%-28s %-6s %8zu %12.1f %12.1f %12.1f\n", operation, path, names.size (),
+            ns [ns.size () / 2], ns [std::min (ns.size () - 1, ns.size () * 99 / 100)], total / ns.size ());
 }
 
+// Every count-th name, for walks too slow to run on everything
+std::vector <std::string> sample_names (const std::vector <std::string>& names, size_t limit)
+{
+  if (limit == 0 || names.size () <= limit)
+    return names;
 
-int main (const int argc, const char** argv)
+  std::vector <std::string> sample;
+  for (size_t i = 0; i < limit; i++)
+    sample.push_back (names [i * names.size () / limit]);
+
+  return sample;
+}
+
+// glvs bench [-r registry.xml] [-n NAMES]; -n caps the names each document walk is timed on
+int bench (const int argc, const char** argv)
 {
+  const char* registry_path = "gl.xml";
+  size_t      dom_limit     = 0;
+
+  for (int i = 2; i < argc; i++) {
+    if ((! strcmp (argv [i], "-r")) && i + 1 < argc) {
+      registry_path = argv [++i];
+    } else if ((! strcmp (argv [i], "-n")) && i + 1 < argc) {
+      dom_limit = (size_t)strtoul (argv [++i], NULL, 10);
+    } else {
+      printf (" @ ERROR: Unknown option '%s'\n", argv [i]);
+      return -2;
+    }
+  }
+
+  glv_file       xml_file;
   xml_document<> glv_xml;
+  glv_db_builder builder;
 
-  std::ifstream     xml_file ("gl.xml");
-  std::stringstream xml_buffer;
+  if (! load_file (registry_path, xml_file)) {
+    printf (" @ ERROR: Cannot open '%s'\n", registry_path);
+    return -2;
+  }
 
-  if (! xml_file.is_open ()) {
-    printf (" @ ERROR: Cannot open 'gl.xml'\n");
+  glv_xml.parse <glv_parse_flags> (const_cast <char *> (xml_file.data));
+  xml_node<>* registry = glv_xml.first_node ("registry");
+  if (! build_db (builder, registry))
     return -2;
+
+  const glv_db db = builder.view ();
+
+  std::vector <std::string> commands, enums, misses;
+  for (glv_id i = 0; i < db.names.count; i++) {
+    if (db.names [i].command != GLV_NONE)
+      commands.push_back (std::string (db.name (i)));
+    if (db.names [i].enum_id != GLV_NONE)
+      enums.push_back (std::string (db.name (i)));
   }
 
-  xml_buffer << xml_file.rdbuf ();
-  xml_file.close ();
+  // Near misses, so a miss cannot be rejected on the first character
+  for (size_t i = 0; i < commands.size () + enums.size (); i++)
+    misses.push_back ((i < commands.size () ? commands [i] : enums [i - commands.size ()]) + "_X");
 
-  std::string xml_str (xml_buffer.str ());
-  glv_xml.parse <0> (&xml_str [0]);
+  const std::vector <std::string> dom_commands = sample_names (commands, dom_limit);
+  const std::vector <std::string> dom_enums    = sample_names (enums,    dom_limit);
+  const std::vector <std::string> dom_misses   = sample_names (misses,   dom_limit);
+  const uint32_t                  reps         = 64;
 
-  glv_registry   = glv_xml.first_node ();
-  glv_extensions = glv_registry->first_node ("extensions");
-  glv_commands   = glv_registry->first_node ("commands");
-  glv_features   = glv_registry->first_node ("feature");
-  glv_enums      = glv_registry->first_node ("enums");
+  xml_node<>* first_feature = registry->first_node ("feature");
 
-  xml_node<>* feature = glv_features;
-  while (feature != NULL) {
-    printf ("Feature: [%5s]   %24s   (%2.1f)\n", feature->first_attribute ("api")->value    (),
-                                                 feature->first_attribute ("name")->value   (),
-                                           atof (feature->first_attribute ("number")->value ()));
-    feature = feature->next_sibling ("feature");
-  }
+  printf ("glvs bench: '%s', %zu commands, %zu enums, %zu misses; indexed lookups repeated %u times per name\n\n",
+            registry_path, commands.size (), enums.size (), misses.size (), reps);
+  printf ("%-28s %-6s %8s %12s %12s %12s\n", "operation", "path", "names", "p50 ns", "p99 ns", "mean ns");
 
-  printf ("\n");
+  auto index_command = [&db] (std::string_view name) { return (uintptr_t)find_command (db, name); };
+  auto dom_command   = [registry] (std::string_view name) { return (uintptr_t)dom_find_command (registry, name); };
+  run_bench ("find_command",        "index", commands,     reps, index_command);
+  run_bench ("find_command",        "dom",   dom_commands, 1,    dom_command);
+  run_bench ("find_command (miss)", "index", misses,       reps, index_command);
+  run_bench ("find_command (miss)", "dom",   dom_misses,   1,    dom_command);
 
-  printf ("Enter OpenGL name to search for: ");
+  auto index_enum = [&db] (std::string_view name) { return (uintptr_t)find_enum (db, name); };
+  auto dom_enum   = [registry] (std::string_view name) { return (uintptr_t)dom_find_enum (registry, name); };
+  run_bench ("find_enum",        "index", enums,      reps, index_enum);
+  run_bench ("find_enum",        "dom",   dom_enums,  1,    dom_enum);
+  run_bench ("find_enum (miss)", "index", misses,     reps, index_enum);
+  run_bench ("find_enum (miss)", "dom",   dom_misses, 1,    dom_enum);
+
+  // find_action and its find_next_action chain, for each verb: the whole lifecycle of a name
+  auto index_actions = [&db] (std::string_view name) {
+    const glv_id id = find_name (db, name);
+    return id != GLV_NONE ? (uintptr_t)find_actions (db, id).count : 0;
+  };
+  auto dom_actions = [first_feature] (std::string_view name) {
+    uintptr_t found = 0;
+    for (int verb = 0; verb < GLV_NUM_VERBS; verb++) {
+      for (xml_node<>* feature = dom_find_action (first_feature, name, glv_verb_names [verb]); feature != NULL;
+                       feature = dom_find_action (feature->next_sibling ("feature"), name, glv_verb_names [verb]))
+        ++found;
+    }
+    return found;
+  };
+  run_bench ("find_action chain",        "index", commands,     reps, index_actions);
+  run_bench ("find_action chain",        "dom",   dom_commands, 1,    dom_actions);
+  run_bench ("find_action chain (enum)", "index", enums,        reps, index_actions);
+  run_bench ("find_action chain (enum)", "dom",   dom_enums,    1,    dom_actions);
+  run_bench ("find_action chain (miss)", "index", misses,       reps, index_actions);
+  run_bench ("find_action chain (miss)", "dom",   dom_misses,   1,    dom_actions);
+
+  auto index_ext_req = [&db] (std::string_view name) {
+    const glv_id id = find_name (db, name);
+    return id != GLV_NONE ? (uintptr_t)find_ext_reqs (db, id).count : 0;
+  };
+  auto dom_ext_req = [registry] (std::string_view name) { return (uintptr_t)dom_find_ext_req (registry, name); };
+  run_bench ("find_ext_req",        "index", commands,     reps, index_ext_req);
+  run_bench ("find_ext_req",        "dom",   dom_commands, 1,    dom_ext_req);
+  run_bench ("find_ext_req (enum)", "index", enums,        reps, index_ext_req);
+  run_bench ("find_ext_req (enum)", "dom",   dom_enums,    1,    dom_ext_req);
+  run_bench ("find_ext_req (miss)", "index", misses,       reps, index_ext_req);
+  run_bench ("find_ext_req (miss)", "dom",   dom_misses,   1,    dom_ext_req);
+
+  // Every command aliasing the one named, which the document can only answer by scanning all commands
+  auto index_aliases = [&db] (std::string_view name) {
+    const glv_id command = find_command (db, name);
+    return command != GLV_NONE ? (uintptr_t)find_command_aliases (db, command) : 0;
+  };
+  auto dom_aliases = [registry] (std::string_view name) {
+    xml_node<>* command = dom_find_command (registry, name);
+    uintptr_t   found   = 0;
+    if (command != NULL) {
+      for (xml_node<>* alias = dom_find_next_command_alias (command->parent ()->first_node ("command"), name); alias != NULL;
+                       alias = dom_find_next_command_alias (alias, name))
+        ++found;
+    }
+    return found;
+  };
+  run_bench ("command aliases", "index", commands,     reps, index_aliases);
+  run_bench ("command aliases", "dom",   dom_commands, 1,    dom_aliases);
+
+  // Every enum sharing a value with the one named
+  auto index_enum_aliases = [&db] (std::string_view name) {
+    const glv_id enum_id = find_enum (db, name);
+    return enum_id != GLV_NONE ? (uintptr_t)find_enums_by_value (db, db.enums [enum_id].value).count : 0;
+  };
+  auto dom_enum_aliases = [registry] (std::string_view name) {
+    xml_node<>* enum_entry = dom_find_enum (registry, name);
+    uintptr_t   found      = 0;
+    for (xml_node<>* alias = enum_entry != NULL ? dom_find_next_enum (enum_entry) : NULL; alias != NULL; alias = dom_find_next_enum (alias))
+      ++found;
+    return found;
+  };
+  run_bench ("enum value aliases", "index", enums,     reps, index_enum_aliases);
+  run_bench ("enum value aliases", "dom",   dom_enums, 1,    dom_enum_aliases);
+
+  unload_file (xml_file);
+
+  return 0;
+}
+
+
+//
+// Synthetic registries
+//
+//   'glvs synth' writes a registry in gl.xml's schema with as many commands, enums, groups, features,
+//     extensions, aliases and require blocks as asked for, so parsing, indexing and queries can be
+//     measured at many times gl.xml's size. The same seed always writes the same file.
+//
+struct glv_synth_spec {
+  uint64_t seed;
+  uint32_t commands;
+  uint32_t enums;
+  uint32_t groups;
+  uint32_t features;
+  uint32_t extensions;
+  uint32_t aliases;        // Vendor-suffixed commands aliasing a core command
+  uint32_t require_blocks; // <require> blocks per feature and extension
+};
+
+// splitmix64; small, fast, and the same on every platform
+uint64_t next_random (uint64_t& state)
+{
+  uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+uint32_t random_below (uint64_t& state, uint32_t limit)
+{
+  return limit != 0 ? (uint32_t)(next_random (state) % limit) : 0;
+}
+
+const char* const glv_synth_verbs  [] = { "Get", "Set", "Bind", "Draw", "Gen", "Delete", "Is", "Create", "Update", "Query", "Map", "Copy" };
+const char* const glv_synth_nouns  [] = { "Buffer", "Texture", "Program", "Shader", "Sampler", "Query", "Framebuffer", "Renderbuffer",
+                                          "VertexArray", "Pipeline", "Fence", "Uniform", "Image", "Attrib", "Stream" };
+const char* const glv_synth_tails  [] = { "", "v", "fv", "iv", "uiv", "i", "f", "d" };
+const char* const glv_synth_words  [] = { "TEXTURE", "BUFFER", "COLOR", "DEPTH", "STENCIL", "SAMPLE", "MAX", "FORMAT", "BINDING",
+                                          "COMPONENT", "UNIFORM", "PROGRAM", "SHADER", "QUERY", "RESULT", "LEVEL", "MODE", "TARGET" };
+const char* const glv_synth_vendor [] = { "ARB", "EXT", "KHR", "OES", "NV", "AMD", "INTEL", "APPLE" };
+const char* const glv_synth_ptypes [] = { "GLenum", "GLuint", "GLint", "GLsizei", "GLfloat", "GLboolean", "GLbitfield", "GLdouble" };
+
+#define GLV_SYNTH_PICK(array, state) array [random_below (state, sizeof (array) / sizeof (array [0]))]
+
+// Core names come first in each list; a vendor's names end in its suffix
+std::string synth_command_name (uint64_t& state, uint32_t i)
+{
   char name [128];
-  scanf ("%s", name);
-
-  xml_node<>* command_node = find_command (name);
-  xml_node<>* enum_node    = find_enum    (name);
-
-  // First search commands
-  if (command_node != NULL) {
-    printf ("--------------------------------\n");
-    printf (" >> Command:  ");
-
-    xml_node<>* return_type = command_node->first_node ("proto")->first_node ("ptype");
-    if (return_type != NULL)
-      printf ("%s ", return_type->value ());
-
-    printf ("%s%s (", command_node->first_node ("proto")->value (),
-                      command_node->first_node ("proto")->first_node ("name")->value ());
-
-    xml_node<>* param = command_node->first_node ("param");
-    if (param != NULL) {
-      while (param != NULL) {
-        xml_node<>* ptype = param->first_node ("ptype");
-        if (ptype != NULL)
-          printf ("%s ", ptype->value ());
-        printf ("%s%s", param->value (),
-                        param->first_node ("name")->value  ());
-        param = param->next_sibling ("param");
-
-        if (param != NULL)
-          printf (", ");
-      }
-    } else {
-      printf ("void");
+  snprintf (name, sizeof (name), "gl%s%s%u%s", GLV_SYNTH_PICK (glv_synth_verbs, state), GLV_SYNTH_PICK (glv_synth_nouns, state),
+                                               i, GLV_SYNTH_PICK (glv_synth_tails, state));
+  return name;
+}
+
+std::string synth_enum_name (uint64_t& state, uint32_t i)
+{
+  char name [128];
+  snprintf (name, sizeof (name), "GL_%s_%s_%u", GLV_SYNTH_PICK (glv_synth_words, state), GLV_SYNTH_PICK (glv_synth_words, state), i);
+  return name;
+}
+
+// The names of features and extensions, and which enums and commands each one requires
+struct glv_synth_unit {
+  std::string            name;
+  std::vector <uint32_t> enums;
+  std::vector <uint32_t> commands;
+};
+
+void write_synth_requires (FILE* out, const glv_synth_unit& unit, uint32_t blocks, const std::vector <std::string>& enum_names,
+                           const std::vector <std::string>& command_names)
+{
+  blocks = std::max (blocks, 1u);
+
+  for (uint32_t b = 0; b < blocks; b++) {
+    fprintf (out, "            <require comment=\"Block %u of %s\">\n", b, unit.name.c_str ());
+    for (size_t i = b; i < unit.enums.size (); i += blocks)
+      fprintf (out, "                <enum name=\"%s\"/>\n", enum_names [unit.enums [i]].c_str ());
+    for (size_t i = b; i < unit.commands.size (); i += blocks)
+      fprintf (out, "                <command name=\"%s\"/>\n", command_names [unit.commands [i]].c_str ());
+    fprintf (out, "            </require>\n");
+  }
+}
+
+// Prints its own errors
+bool write_synth_registry (const char* path, const glv_synth_spec& spec)
+{
+  uint64_t state = spec.seed;
+
+  // A tenth of the enums are group bits, a fifth of the rest extension-only; likewise for commands
+  const uint32_t num_bitmasks  = (spec.groups + 1) / 2;
+  const uint32_t num_bits      = std::min (spec.enums / 10, num_bitmasks * 16);
+  const uint32_t core_enums    = spec.enums - (spec.enums - num_bits) / 5;
+  const uint32_t num_aliases   = std::min (spec.aliases, spec.commands / 2);
+  const uint32_t core_commands = std::max ((spec.commands - num_aliases) * 4 / 5, std::min (spec.commands, 1u));
+
+  std::vector <std::string> enum_names, command_names;
+  for (uint32_t i = 0; i < spec.enums; i++)
+    enum_names.push_back (synth_enum_name (state, i));
+  for (uint32_t i = 0; i < spec.commands; i++)
+    command_names.push_back (synth_command_name (state, i));
+
+  // Aliases are the last commands, renamed after the core command they alias; a target's nth alias takes
+  //   the nth vendor suffix, numbered once the vendors run out
+  std::vector <uint32_t> alias_of (spec.commands, ~0u);
+  std::vector <uint32_t> aliases_of (core_commands, 0);
+  for (uint32_t i = 0; i < num_aliases && core_commands != 0; i++) {
+    const uint32_t command = spec.commands - num_aliases + i;
+    const uint32_t target  = random_below (state, core_commands);
+    const uint32_t nth     = aliases_of [target]++;
+    alias_of [command]      = target;
+    command_names [command] = command_names [target] + glv_synth_vendor [nth % 8] + (nth >= 8 ? std::to_string (nth / 8) : std::string ());
+  }
+
+  // The name index assumes every name is defined once
+  std::unordered_set <std::string_view> defined;
+  for (size_t i = 0; i < enum_names.size () + command_names.size (); i++) {
+    const std::string& name = i < enum_names.size () ? enum_names [i] : command_names [i - enum_names.size ()];
+    if (! defined.insert (name).second) {
+      printf (" @ ERROR: Synthetic name '%s' is generated twice\n", name.c_str ());
+      return false;
+    }
+  }
+
+  FILE* out = fopen (path, "wb");
+  if (out == NULL) {
+    printf (" @ ERROR: Cannot write '%s'\n", path);
+    return false;
+  }
+
+  std::vector <char> out_buffer (1 << 20);
+  setvbuf (out, out_buffer.data (), _IOFBF, out_buffer.size ());
+
+  fprintf (out, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<registry>\n"
+                "    <comment>\nSynthetic registry written by 'glvs synth' (seed %llu): %u commands, %u enums, %u groups,\n"
+                "%u features, %u extensions, %u aliases, %u require blocks each.\n    </comment>\n",
+                (unsigned long long)spec.seed, spec.commands, spec.enums, spec.groups, spec.features, spec.extensions,
+                num_aliases, spec.require_blocks);
+
+  fprintf (out, "    <types>\n"
+                "        <type name=\"stddef\">#include &lt;stddef.h&gt;</type>\n"
+                "        <type>typedef unsigned int <name>GLenum</name>;</type>\n"
+                "        <type>typedef unsigned char <name>GLboolean</name>;</type>\n"
+                "        <type>typedef unsigned int <name>GLbitfield</name>;</type>\n"
+                "        <type>typedef int <name>GLint</name>;</type>\n"
+                "        <type>typedef unsigned int <name>GLuint</name>;</type>\n"
+                "        <type>typedef int <name>GLsizei</name>;</type>\n"
+                "        <type>typedef float <name>GLfloat</name>;</type>\n"
+                "        <type>typedef double <name>GLdouble</name>;</type>\n"
+                "        <type requires=\"stddef\">typedef ptrdiff_t <name>GLintptr</name>;</type>\n"
+                "    </types>\n\n");
+
+  // Value groups list their members in <groups>; bitmask groups are <enums type="bitmask"> blocks below
+  std::vector <std::vector <uint32_t> > value_groups (spec.groups - num_bitmasks);
+  for (uint32_t i = num_bits; i < spec.enums && (! value_groups.empty ()); i++) {
+    if (random_below (state, 4) == 0)
+      value_groups [random_below (state, (uint32_t)value_groups.size ())].push_back (i);
+  }
+
+  fprintf (out, "    <groups>\n");
+  for (size_t g = 0; g < value_groups.size (); g++) {
+    fprintf (out, "        <group name=\"SynthGroup%zu\">\n", g);
+    for (size_t i = 0; i < value_groups [g].size (); i++)
+      fprintf (out, "            <enum name=\"%s\"/>\n", enum_names [value_groups [g][i]].c_str ());
+    fprintf (out, "        </group>\n");
+  }
+  fprintf (out, "    </groups>\n\n");
+
+  for (uint32_t g = 0; g < num_bitmasks && num_bits != 0; g++) {
+    fprintf (out, "    <enums namespace=\"GL\" group=\"SynthMask%u\" type=\"bitmask\">\n", g);
+    for (uint32_t i = g, bit = 0; i < num_bits; i += num_bitmasks, bit++)
+      fprintf (out, "        <enum value=\"0x%08X\" name=\"%s\"/>\n", 1u << (bit % 32), enum_names [i].c_str ());
+    fprintf (out, "    </enums>\n\n");
+  }
+
+  // Values are unique except for one enum in twenty, which repeats an earlier value under an alias
+  uint32_t value = 0x10000;
+  for (uint32_t i = num_bits; i < spec.enums; i += 16) {
+    fprintf (out, "    <enums namespace=\"GL\" start=\"0x%05X\" end=\"0x%05X\" vendor=\"%s\">\n", value, value + 15,
+                  GLV_SYNTH_PICK (glv_synth_vendor, state));
+    for (uint32_t j = i; j < std::min (i + 16, spec.enums); j++) {
+      if (j > num_bits && random_below (state, 20) == 0)
+        fprintf (out, "        <enum value=\"0x%05X\" name=\"%s\" alias=\"%s\"/>\n", value - 1, enum_names [j].c_str (), enum_names [j - 1].c_str ());
+      else
+        fprintf (out, "        <enum value=\"0x%05X\" name=\"%s\"/>\n", value++, enum_names [j].c_str ());
     }
+    fprintf (out, "    </enums>\n\n");
+  }
 
-    printf (")\n\n");
+  fprintf (out, "    <commands namespace=\"GL\">\n");
+  for (uint32_t i = 0; i < spec.commands; i++) {
+    const uint32_t target = alias_of [i] != ~0u ? alias_of [i] : i;
+    uint64_t       shape  = spec.seed ^ (0x51A7ull * (target + 1)); // An alias has its target's signature
 
-    xml_node<>* extension = find_ext_req (name);
-    if (extension != NULL) {
-      printf ("  * Provided by %s (%s)\n\n", extension->first_attribute ("name")->value (), extension->first_attribute ("supported")->value ());
+    fprintf (out, "        <command>\n"
+                  "            <proto>void <name>%s</name></proto>\n", command_names [i].c_str ());
+
+    const uint32_t num_params = random_below (shape, 7);
+    for (uint32_t p = 0; p < num_params; p++) {
+      const char* ptype = GLV_SYNTH_PICK (glv_synth_ptypes, shape);
+      if ((! strcmp (ptype, "GLenum")) && (! value_groups.empty ()))
+        fprintf (out, "            <param group=\"SynthGroup%u\"><ptype>%s</ptype> <name>p%u</name></param>\n",
+                      random_below (shape, (uint32_t)value_groups.size ()), ptype, p);
+      else if (random_below (shape, 4) == 0)
+        fprintf (out, "            <param len=\"count\">const <ptype>%s</ptype> *<name>p%u</name></param>\n", ptype, p);
+      else
+        fprintf (out, "            <param><ptype>%s</ptype> <name>p%u</name></param>\n", ptype, p);
     }
 
-    const char* verbs [] = { "require", "deprecate",     "remove"     };
-    const char* desc  [] = { "Core in", "Deprecated in", "Removed in" };
+    if (alias_of [i] != ~0u)
+      fprintf (out, "            <alias name=\"%s\"/>\n", command_names [alias_of [i]].c_str ());
+    fprintf (out, "        </command>\n");
+  }
+  fprintf (out, "    </commands>\n\n");
 
-    for (int i = 0; i < sizeof (verbs) / sizeof (const char *); i++) {
-      xml_node<>* command = find_action (name, verbs [i]);
+  // Core names are split over the features in order; a quarter of the way in, the core profile removes a
+  //   few of what came before, and the last feature brings some of those back
+  std::vector <glv_synth_unit> features (std::max (spec.features, 1u));
+  for (uint32_t i = 0; i < core_enums; i++)
+    features [(uint64_t)i * features.size () / core_enums].enums.push_back (i);
+  for (uint32_t i = 0; i < core_commands; i++)
+    features [(uint64_t)i * features.size () / core_commands].commands.push_back (i);
 
-      while (command != NULL) {
-        printf ("  * %-15s %24s    (%5s %2.1f)\n", desc [i],
-                                                  command->first_attribute ("name")->value   (),
-                                                  command->first_attribute ("api")->value    (),
-                                            atof (command->first_attribute ("number")->value ()));
-        command = find_next_action (name, command, verbs [i]);
-      }
+  const size_t   removing = features.size () / 4;
+  glv_synth_unit removed;
+  for (size_t f = 0; f < removing; f++) {
+    for (size_t i = 0; i < features [f].commands.size (); i += 8)
+      removed.commands.push_back (features [f].commands [i]);
+    for (size_t i = 0; i < features [f].enums.size (); i += 8)
+      removed.enums.push_back (features [f].enums [i]);
+  }
+  removed.name = "the core profile";
+
+  for (size_t f = 0; f < features.size (); f++) {
+    char number [32];
+    snprintf (number, sizeof (number), "%zu.%zu", 1 + f / 10, f % 10);
+    features [f].name = "GL_VERSION_" + std::to_string (1 + f / 10) + "_" + std::to_string (f % 10);
+
+    fprintf (out, "    <feature api=\"gl\" name=\"%s\" number=\"%s\">\n", features [f].name.c_str (), number);
+    write_synth_requires (out, features [f], spec.require_blocks, enum_names, command_names);
+
+    if (f == removing && f != 0) {
+      fprintf (out, "            <remove profile=\"core\">\n");
+      for (size_t i = 0; i < removed.enums.size (); i++)
+        fprintf (out, "                <enum name=\"%s\"/>\n", enum_names [removed.enums [i]].c_str ());
+      for (size_t i = 0; i < removed.commands.size (); i++)
+        fprintf (out, "                <command name=\"%s\"/>\n", command_names [removed.commands [i]].c_str ());
+      fprintf (out, "            </remove>\n");
     }
 
-    xml_node<>* command_alias = find_next_command_alias (command_node, glv_commands->first_node ("command"));
-    if (command_alias != NULL)
-      printf ("\n");
+    if (f + 1 == features.size () && f > removing && (! removed.commands.empty ()))
+      fprintf (out, "            <require profile=\"core\">\n"
+                    "                <command name=\"%s\"/>\n"
+                    "            </require>\n", command_names [removed.commands [0]].c_str ());
+
+    fprintf (out, "    </feature>\n");
+  }
+  fprintf (out, "\n");
+
+  // Extension-only names are dealt out round robin; each extension also re-requires a few core names,
+  //   as ARB extensions that were later promoted do
+  std::vector <glv_synth_unit> extensions (spec.extensions);
+  for (size_t e = 0; e < extensions.size (); e++) {
+    const char* vendor = glv_synth_vendor [e % 8];
+    extensions [e].name = std::string ("GL_") + vendor + "_synth_extension_" + std::to_string (e);
+  }
+
+  for (uint32_t i = core_enums; i < spec.enums && (! extensions.empty ()); i++)
+    extensions [i % extensions.size ()].enums.push_back (i);
+  for (uint32_t i = core_commands; i < spec.commands && (! extensions.empty ()); i++)
+    extensions [alias_of [i] != ~0u ? (i - (spec.commands - num_aliases)) % extensions.size () : i % extensions.size ()].commands.push_back (i);
+
+  fprintf (out, "    <extensions>\n");
+  for (size_t e = 0; e < extensions.size (); e++) {
+    glv_synth_unit& extension = extensions [e];
+    for (uint32_t i = 0, n = random_below (state, 3); i < n && core_commands != 0; i++)
+      extension.commands.push_back (random_below (state, core_commands));
+
+    static const char* const supported [] = { "gl|glcore", "gl", "gles2", "gl|glcore|gles2", "gles1|gles2" };
+    fprintf (out, "        <extension name=\"%s\" supported=\"%s\">\n", extension.name.c_str (), supported [e % 5]);
+    write_synth_requires (out, extension, spec.require_blocks, enum_names, command_names);
+    fprintf (out, "        </extension>\n");
+  }
+  fprintf (out, "    </extensions>\n"
+                "</registry>\n");
+
+  if (fclose (out) != 0) {
+    printf (" @ ERROR: Cannot write '%s'\n", path);
+    return false;
+  }
+
+  return true;
+}
+
+// glvs synth [-s SEED] [-x SCALE] [--commands N] [--enums N] ... [-o synth.xml]; counts default to
+//   roughly gl.xml's, times SCALE
+int synth (const int argc, const char** argv)
+{
+  glv_synth_spec spec = { 1, 3000, 5000, 120, 20, 600, 300, 1 };
+  const char*    path = "synth.xml";
+  double         scale = 1.0;
+
+  struct { const char* option; uint32_t* count; } counts [] = {
+    { "--commands",   &spec.commands       },
+    { "--enums",      &spec.enums          },
+    { "--groups",     &spec.groups         },
+    { "--features",   &spec.features       },
+    { "--extensions", &spec.extensions     },
+    { "--aliases",    &spec.aliases        },
+    { "--requires",   &spec.require_blocks }
+  };
+  std::vector <bool> counted (sizeof (counts) / sizeof (counts [0]), false);
 
-    while (command_alias != NULL) {
-      printf (" >> Command Alias: %s <<\n", command_alias->first_node ("proto")->first_node ("name")->value ());
+  for (int i = 2; i < argc; i++) {
+    const char* arg   = argv [i];
+    bool        known = i + 1 < argc;
+
+    if (! known) {
+    } else if (! strcmp (arg, "-o")) {
+      path = argv [++i];
+    } else if (! strcmp (arg, "-s")) {
+      spec.seed = strtoull (argv [++i], NULL, 10);
+    } else if (! strcmp (arg, "-x")) {
+      scale = atof (argv [++i]);
+    } else {
+      known = false;
+      for (size_t c = 0; c < counted.size () && (! known); c++) {
+        if (! strcmp (arg, counts [c].option)) {
+          *counts [c].count = (uint32_t)strtoul (argv [++i], NULL, 10);
+          counted [c] = known = true;
+        }
+      }
+    }
 
-      xml_node<>* command_extension = find_ext_req (command_alias->first_node ("proto")->first_node ("name")->value ());
-      if (command_extension != NULL)
-        printf ("  * Provided by %s (%s)\n\n", command_extension->first_attribute ("name")->value (), command_extension->first_attribute ("supported")->value ());
-      command_alias = find_next_command_alias (command_node, command_alias);
+    if (! known) {
+      printf (" @ ERROR: Unknown option '%s'\n", arg);
+      return -2;
     }
   }
 
-  // Then search enums
-  else if (enum_node != NULL) {
-    printf ("--------------------------------\n");
+  // Scale whatever was not given explicitly; require blocks per unit stay as they are
+  for (size_t c = 0; c + 1 < counted.size (); c++) {
+    if (! counted [c])
+      *counts [c].count = (uint32_t)(*counts [c].count * scale + 0.5);
+  }
+
+  const auto start = std::chrono::steady_clock::now ();
+
+  if (! write_synth_registry (path, spec))
+    return -2;
+
+  struct stat info;
+  const long long bytes = stat (path, &info) == 0 ? (long long)info.st_size : 0;
+
+  printf ("Wrote '%s' (%.1f MB) in %.1f ms: %u commands, %u enums, %u groups, %u features, %u extensions, seed %llu\n",
+            path, bytes / (1024.0 * 1024.0), elapsed_ms (start), spec.commands, spec.enums, spec.groups,
+            spec.features, spec.extensions, (unsigned long long)spec.seed);
+
+  return 0;
+}
+
+
+// glvs complete PREFIX prints every name starting with PREFIX, one per line. It also works as a bash
+//   completer (complete -C 'glvs complete' glvs), which passes the command, the word being completed
+//   and the previous word, and sets $COMP_LINE.
+int complete (const int argc, const char** argv)
+{
+  const bool  from_bash = getenv ("COMP_LINE") != NULL;
+  const char* word      = from_bash ? (argc > 3 ? argv [3] : "") : (argc > 2 ? argv [2] : "");
+  const char* previous  = from_bash && argc > 4 ? argv [4] : "";
+
+  // Options and the files they take are left to the shell
+  if (word [0] == '-' || (! strcmp (previous, "-r")) || (! strcmp (previous, "-l")))
+    return 0;
+
+  glv_registry registry;
+  if (! open_registry (NULL, registry, NULL))
+    return -2;
+
+  const glv_db&            db      = registry.db;
+  const glv_table <glv_id> matches = find_names_by_prefix (db, word);
+
+  for (uint32_t i = 0; i < matches.count; i++) {
+    if (is_named_entity (db, matches [i]))
+      printf ("%.*s\n", GLV_FMT_STR (db.name (matches [i])));
+  }
+
+  return 0;
+}
+
+void print_usage (void)
+{
+  printf ("usage: glvs [-r registry.xml]                           interactive lookup\n"
+          "       glvs [-r registry.xml] [-j N] NAME... [-l FILE]  look up every NAME and every name listed in FILE\n"
+          "                                                          ('-' or '-l -' reads names from stdin)\n"
+          "                                                          a NAME ending in '*' lists every name with that prefix\n"
+          "                                                          other wildcards (glUniform*fv) make NAME a glob, and\n"
+          "                                                          /REGEX/ searches names with a regular expression\n"
+          "                                                          a number (0x0502, 36281, -2) lists every enum with that value\n"
+          "                                                          VALUE:GROUP decodes a mask into the named bits of a bitmask\n"
+          "                                                            group, VALUE: in whichever bitmask groups explain it best\n"
+          "                                                          API:VERSION[:PROFILE] (gl:4.5:core, gles2:3.2) lists every\n"
+          "                                                            command and enum that version makes available\n"
+          "                                                          -j N answers on N threads (0: one per core)\n"
+          "                                                          --json answers each name with one line of JSON\n"
+          "                                                          --stats reports load phases, lookup times and parser\n"
+          "                                                            memory on stderr (as JSON with --json)\n"
+          "       glvs compile [gl.xml [gl.glvsdb]]                write a binary snapshot of a registry\n"
+          "       glvs embed   [gl.xml [glvs_registry.h]]          write a registry as constexpr tables\n"
+          "       glvs header [-r registry.xml] [-o NAME] API:VERSION[:PROFILE] [EXTENSION...]\n"
+          "                                                        write NAME.h and NAME.c: types, enums and a dispatch\n"
+          "                                                          table for a version and extensions, and its loader\n"
+          "       glvs diff old.xml new.xml                        list what changed between two registries\n"
+          "       glvs bench [-r registry.xml] [-n NAMES]          time every lookup, document walk against index\n"
+          "       glvs synth [-s SEED] [-x SCALE] [-o synth.xml]   write a synthetic registry, SCALE times gl.xml's size;\n"
+          "                  [--commands N] [--enums N] ...         also --groups --features --extensions --aliases --requires\n"
+          "       glvs complete PREFIX                             print every name starting with PREFIX\n"
+          "       glvs serve [-r registry.xml] [socket]            keep a registry loaded and answer lookups over a socket\n");
+}
+
+int main (const int argc, const char** argv)
+{
+  if (argc > 1 && (! strcmp (argv [1], "compile")))
+    return compile (argc, argv, false);
+
+  if (argc > 1 && (! strcmp (argv [1], "embed")))
+    return compile (argc, argv, true);
+
+  if (argc > 1 && (! strcmp (argv [1], "complete")))
+    return complete (argc, argv);
 
-    const long value = strtol (enum_node->first_attribute ("value")->value   (), NULL, 16);
-    printf(" >> Enum:   %s is 0x%04X\n\n", enum_node->first_attribute ("name")->value (), value);
+  if (argc > 1 && (! strcmp (argv [1], "header")))
+    return generate_loader (argc, argv);
 
-    // For non-core tokens, find the extension
-    xml_node<>* enum_core = find_action (name, "require");
-    xml_node<>* enum_extension = find_ext_req (enum_node->first_attribute ("name")->value ());
-    if (enum_extension != NULL)
-      printf ("  * Provided by %s (%s)\n\n", enum_extension->first_attribute ("name")->value (), enum_extension->first_attribute ("supported")->value ());
+  if (argc > 1 && (! strcmp (argv [1], "diff")))
+    return diff_registries (argc, argv);
 
-    const char* verbs [] = { "require", "deprecate",     "remove"     };
-    const char* desc  [] = { "Core in", "Deprecated in", "Removed in" };
+  if (argc > 1 && (! strcmp (argv [1], "bench")))
+    return bench (argc, argv);
 
-    for (int i = 0; i < sizeof (verbs) / sizeof (const char *); i++) {
-      xml_node<>* node = find_action (name, verbs [i]);
+  if (argc > 1 && (! strcmp (argv [1], "synth")))
+    return synth (argc, argv);
 
-      while (node != NULL) {
-        printf ("  * %-15s %24s    (%5s %2.1f)\n", desc [i],
-                                                   node->first_attribute ("name")->value   (),
-                                                   node->first_attribute ("api")->value    (),
-                                             atof (node->first_attribute ("number")->value ()));
-        node = find_next_action (name, node, verbs [i]);
+  if (argc > 1 && (! strcmp (argv [1], "serve"))) {
+#if ! defined (_WIN32)
+    return serve (argc, argv);
+#else
+    printf (" @ ERROR: 'glvs serve' needs Unix domain sockets\n");
+    return -2;
+#endif
+  }
+
+  const char*             registry_path = NULL;
+  unsigned                num_threads   = 1;
+  glv_format              format        = GLV_FORMAT_TEXT;
+  bool                    stats         = false;
+  std::vector <glv_input> inputs;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv [i];
+
+    if ((! strcmp (arg, "-r")) || (! strcmp (arg, "--registry"))) {
+      if (++i == argc) {
+        print_usage ();
+        return -2;
+      }
+      registry_path = argv [i];
+    } else if ((! strcmp (arg, "-j")) || (! strcmp (arg, "--jobs"))) {
+      if (++i == argc) {
+        print_usage ();
+        return -2;
+      }
+      num_threads = (unsigned)strtoul (argv [i], NULL, 10);
+      if (num_threads == 0)
+        num_threads = std::max (std::thread::hardware_concurrency (), 1u);
+    } else if ((! strcmp (arg, "-l")) || (! strcmp (arg, "--list"))) {
+      if (++i == argc) {
+        print_usage ();
+        return -2;
       }
+      glv_input input = { argv [i], true };
+      inputs.push_back (input);
+    } else if (! strcmp (arg, "--json")) {
+      format = GLV_FORMAT_JSON;
+    } else if (! strcmp (arg, "--stats")) {
+      stats = true;
+    } else if (! strcmp (arg, "-")) {
+      glv_input input = { arg, true };
+      inputs.push_back (input);
+    } else if ((! strcmp (arg, "-h")) || (! strcmp (arg, "--help"))) {
+      print_usage ();
+      return 0;
+    } else if (arg [0] == '-' && (! isdigit ((uint8_t)arg [1]))) {
+      printf (" @ ERROR: Unknown option '%s'\n", arg);
+      print_usage ();
+      return -2;
+    } else {
+      glv_input input = { arg, false };
+      inputs.push_back (input);
     }
+  }
+
+  // JSON has no interactive form; with no names it answers the names on stdin
+  if (format == GLV_FORMAT_JSON && inputs.empty ()) {
+    glv_input input = { "-", true };
+    inputs.push_back (input);
+  }
+
+  // --stats measures this process loading the registry, so it never hands the batch to a daemon
+#if ! defined (_WIN32)
+  std::vector <std::string> names; // Keeps the names of a batch the daemon could not answer alive
+  int                       result;
+  if ((! inputs.empty ()) && (! stats) && run_remote_batch (registry_path, inputs, names, format, result))
+    return result;
+#endif
+
+  glv_registry    registry;
+  glv_parse_stats parse_stats;
+  if (! open_registry (registry_path, registry, stats ? &parse_stats : NULL)) {
+    printf (" @ ERROR: Cannot open '%s'\n", registry_path != NULL ? registry_path : "gl.xml");
+    return -2;
+  }
+
+  const glv_db&    db     = registry.db;
+  glv_batch_totals totals = glv_batch_totals ();
 
-    printf ("\n");
+  if (! inputs.empty ()) {
+#if ! defined (_WIN32)
+    const int batch_result = num_threads > 1 ? run_parallel_batch (db, inputs, format, num_threads, totals) :
+                                               run_batch          (db, inputs, format, totals);
+#else
+    const int batch_result = run_batch (db, inputs, format, totals);
+#endif
 
-    xml_node<>* enum_alias = find_next_enum (enum_node);
-    while (enum_alias != NULL) {
-      printf (" >> Enum Alias: %s <<\n", enum_alias->first_attribute ("name")->value ());
+    if (batch_result != 0)
+      return batch_result;
 
-      xml_node<>* extension = find_ext_req (enum_alias->first_attribute ("name")->value ());
-      if (extension != NULL)
-        printf ("  * Provided by %s (%s)\n\n", extension->first_attribute ("name")->value (), extension->first_attribute ("supported")->value ());
-      enum_alias = find_next_enum (enum_alias);
+    // With --json the stats object carries the counts, so stderr stays one JSON document
+    if (stats && format == GLV_FORMAT_JSON) {
+      fflush           (stdout);
+      write_json_stats (stderr, registry.info, parse_stats, totals);
+      return totals.not_found != 0 ? -1 : 0;
     }
+
+    const int batch_status = finish_batch (totals);
+    if (stats)
+      print_stats (stderr, registry.info, parse_stats, totals);
+
+    return batch_status;
   }
 
-  else {
-    printf ("--------------------------------\n"
-            " @ ERROR: '%s' Not Found In GL Registry!\n",
-            name);
-    return -1;
+  for (uint32_t i = 0; i < db.features.count; i++) {
+    const glv_feature_rec& feature = db.features [i];
+    printf ("Feature: [%5.*s]   %24.*s   (%2.1f)\n", GLV_FMT_STR (db.str  (feature.api)),
+                                                     GLV_FMT_STR (db.name (feature.name)),
+                                    parse_version (db.str (feature.number)));
   }
 
-  return 0;
+  printf ("\n");
+
+  print_load_info (registry.info);
+
+  printf ("Enter OpenGL name to search for: ");
+  char name [128];
+  scanf ("%127s", name);
+
+  // Interactively the one lookup is timed along with printing its answer
+  const std::chrono::steady_clock::time_point start  = std::chrono::steady_clock::now ();
+  const glv_query_status                      status = print_query (db, name);
+
+  if (stats) {
+    totals.query_ms   = elapsed_ms (start);
+    totals.slowest_ms = totals.query_ms;
+    totals.found      = status != GLV_QUERY_NOT_FOUND ? 1 : 0;
+    totals.not_found  = 1 - totals.found;
+    print_stats (stderr, registry.info, parse_stats, totals);
+  }
+
+  return status == GLV_QUERY_NOT_FOUND ? -1 : 0;
 }